@@ -0,0 +1,77 @@
+#ifndef RENDER_AOS_SCENE_HPP
+#define RENDER_AOS_SCENE_HPP
+
+#include "bvh.hpp"
+#include "geometry.hpp"
+#include "parser.hpp"
+#include "ray.hpp"
+#include "scene_cache.hpp"
+#include "scene_reload.hpp"
+#include "shading.hpp"
+#include "shapes.hpp"
+#include "stats.hpp"
+#include "vector.hpp"
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace render::aos {
+
+  // Escena como array de estructuras: un array por tipo de primitivo (sphere_shape,
+  // cylinder_shape) y un único BVH sobre todos. Los arrays siguen el orden de las hojas y
+  // sphere_prefix[k] cuenta las esferas entre las k primeras posiciones, así que cada hoja es
+  // un tramo de esferas y otro de cilindros que se prueban con bucles de un solo tipo.
+  class scene {
+  public:
+    scene(std::vector<Material> const & mats, std::vector<Object> const & objects,
+          accel_kind accel = accel_kind::bvh);
+    // Escena compilada: reutiliza las jerarquías guardadas si existen y solo las construye si no
+    explicit scene(scene_cache const & cache, accel_kind accel = accel_kind::bvh);
+
+    // Búsqueda de la intersección más cercana en [t_min, t_max]
+    [[nodiscard]] bool closest_hit(ray const & r, double t_min, double t_max,
+                                   hit_record & rec) const;
+
+    // Igual, contando en probe las cajas y los primitivos probados (no_probe o ray_stats)
+    template <typename Probe>
+    [[nodiscard]] bool closest_hit(ray const & r, double t_min, double t_max, hit_record & rec,
+                                   Probe & probe) const;
+
+    [[nodiscard]] surface const & material_at(int idx) const;
+
+    // Aplica los cambios no estructurales de diff respecto al análisis del que se construyó la
+    // escena: sustituye los materiales y objetos modificados por los de (mats, objects) y
+    // reajusta las cajas del BVH sin reconstruirlo
+    void update(std::vector<Material> const & mats, std::vector<Object> const & objects,
+                scene_diff const & diff);
+
+    [[nodiscard]] std::vector<sphere_shape> const & get_spheres() const { return spheres; }
+
+    [[nodiscard]] std::vector<cylinder_shape> const & get_cylinders() const { return cylinders; }
+
+    [[nodiscard]] bvh const & get_bvh() const { return hierarchy; }
+
+    // Tiempo de construcción (o adopción) de las jerarquías, en segundos
+    [[nodiscard]] double get_bvh_seconds() const { return bvh_seconds; }
+
+  private:
+    [[nodiscard]] std::size_t size() const;
+    // Si el primitivo en la posición pos (del orden actual) es una esfera
+    [[nodiscard]] bool is_sphere(std::size_t pos) const;
+    // Caja de cada primitivo en el orden actual
+    [[nodiscard]] std::vector<aabb> primitive_bounds() const;
+    void build_bvh();
+    void use_bvh(bvh tree);
+
+    std::vector<surface> materials;
+    std::vector<sphere_shape> spheres;
+    std::vector<cylinder_shape> cylinders;
+    std::vector<std::uint32_t> sphere_prefix;
+    bvh hierarchy;
+    double bvh_seconds = 0.0;
+  };
+
+}  // namespace render::aos
+
+#endif
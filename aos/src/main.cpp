@@ -1,98 +1,270 @@
 // aos/src/main.cpp
+#include "animation.hpp"
+#include "bvh.hpp"
+#include "camera.hpp"
+#include "options.hpp"
 #include "parser.hpp"
-#include <algorithm>
+#include "ppm.hpp"
+#include "progressive.hpp"
+#include "render_server.hpp"
+#include "renderer.hpp"
+#include "scene.hpp"
+#include "scene_cache.hpp"
+#include "scene_reload.hpp"
+#include "stats.hpp"
+#include "thread_pool.hpp"
 #include <array>
-#include <cmath>
 #include <fstream>
 #include <iostream>
 #include <span>
+#include <string>
 #include <string_view>
+#include <utility>
 #include <vector>
 
 namespace {
 
-  // Convierte valor en [0,1] -> 0..255 con corrección gamma
-  int to_u8(double v, double gamma) {
-    v                = std::clamp(v, 0.0, 1.0);
-    double corrected = std::pow(v, 1.0 / gamma);
-    int iv           = static_cast<int>(std::floor(corrected * 255.0 + 0.5));
-    return std::clamp(iv, 0, 255);
+  // Primera opción que el modo elegido (--serve o --compile-scene) no usaría; vacío si ninguna
+  std::string_view conflicting_option(render::options const & opts) {
+    bool const serving = not opts.serve.empty();
+    if (not serving and opts.compile_scene.empty()) {
+      return {};
+    }
+    if (serving and not opts.compile_scene.empty()) {
+      return "--compile-scene";
+    }
+    if (not opts.frames.empty()) {
+      return "--frames";
+    }
+    if (opts.turntable != 0) {
+      return "--turntable";
+    }
+    if (not opts.checkpoint.empty()) {
+      return "--checkpoint";
+    }
+    if (not opts.stats.empty()) {
+      return "--stats";
+    }
+    return {};
   }
 
-}  // namespace
-
-namespace {
+  int validate_args(std::span<char *> args, render::options & opts) {
+    try {
+      opts = render::parse_options(args);
+    } catch (std::exception const & e) {
+      std::cerr << e.what() << "\n";
+      return 1;
+    }
+    if (auto const other = conflicting_option(opts); not other.empty()) {
+      std::string_view const mode = opts.serve.empty() ? "--compile-scene" : "--serve";
+      std::cerr << "Error: Option " << mode << " cannot be combined with " << other << "\n";
+      return 1;
+    }
+    // Al compilar una escena solo se recibe el fichero de texto; el servidor no recibe ninguno
+    std::size_t expected = opts.compile_scene.empty() ? 3 : 1;
+    if (not opts.serve.empty()) {
+      expected = 0;
+    }
+    if (opts.positional.size() != expected) {
+      std::cerr << "Error: Invalid number of arguments: " << opts.positional.size() << "\n";
+      return 1;
+    }
+    return 0;
+  }
 
-  // Escribe PPM (variante P3) siguiendo la especificación del enunciado:
-  // la segunda línea es "número de líneas" (height) seguido de "número de columnas" (width)
-  void write_ppm(std::string const & path, int width, int height,
-                 std::vector<std::array<int, 3>> const & pixels) {
-    std::ofstream ofs(path);
-    if (!ofs) {
-      std::cerr << "Error: Could not open output file: " << path << "\n";
-      std::exit(3);
-    }
-    ofs << "P3\n" << height << " " << width << "\n255\n";
-    for (int r = 0; r < height; ++r) {
-      for (int c = 0; c < width; ++c) {
-        auto p =
-            pixels[static_cast<size_t>(r) * static_cast<size_t>(width) + static_cast<size_t>(c)];
-        ofs << p[0] << " " << p[1] << " " << p[2] << "\n";
-      }
+  // Escena de texto o compilada: la segunda se reconoce por su firma y se carga sin análisis
+  render::aos::scene load_scene(std::string const & path, render::accel_kind accel,
+                                render::work_stealing_pool & pool, render::phase_times & times) {
+    render::stopwatch const clock;
+    if (render::is_scene_cache(path)) {
+      render::scene_cache const cache(path);
+      times.scene_load = clock.seconds();
+      render::aos::scene scn(cache, accel);
+      times.accel_build = scn.get_bvh_seconds();
+      times.scene_build = clock.seconds() - times.scene_load - times.accel_build;
+      return scn;
     }
+    auto const [materials, objects] = parseScene(path, pool);
+    times.scene_load = clock.seconds();
+    render::aos::scene scn(materials, objects, accel);
+    times.accel_build = scn.get_bvh_seconds();
+    times.scene_build = clock.seconds() - times.scene_load - times.accel_build;
+    return scn;
   }
 
-}  // namespace
+  int compile_scene(render::options const & opts) {
+    try {
+      render::work_stealing_pool pool(render::resolve_thread_count(opts.threads));
+      auto const [materials, objects] = parseScene(opts.positional[0], pool);
+      render::aos::scene const scn(materials, objects, render::parse_accel(opts.accel));
+      std::array const hierarchies = {
+        render::cache_hierarchy{render::cached_bvh::aos, &scn.get_bvh()}
+      };
+      render::write_scene_cache(opts.compile_scene, materials, objects, hierarchies);
+      std::cout << "Wrote " << opts.compile_scene << " (" << objects.size() << " objects)\n";
+    } catch (std::exception const & e) {
+      std::cerr << e.what() << "\n";
+      return 2;
+    }
+    return 0;
+  }
 
-namespace {
+  // Modo servidor: el pool y las escenas usadas recientemente se conservan entre trabajos, con
+  // el análisis del que proceden para recargarlas por partes si su fichero cambia. La
+  // configuración se lee en cada trabajo; su clave threads: no se usa porque el pool es fijo.
+  int serve(render::options const & opts) {
+    try {
+      render::work_stealing_pool pool(render::resolve_thread_count(opts.threads));
+      auto const accel  = render::parse_accel(opts.accel);
+      auto const format = render::parse_ppm_format(opts.format);
 
-  int validate_args(std::span<char *> args) {
-    if (args.size() != 4) {
-      std::cerr << "Error: Invalid number of arguments: " << (args.size() - 1) << "\n";
-      return 1;
+      using served_scene = render::reloadable_scene<render::aos::scene>;
+      render::scene_lru<served_scene> scenes(static_cast<std::size_t>(opts.scene_cache));
+      auto const job = [&](render::render_request const & req, std::ostream & out) {
+        Config const cfg = parseConfig(req.config_path);
+        auto const scn   = scenes.get(req.scene_path, [&](served_scene const * previous) {
+          if (render::is_scene_cache(req.scene_path)) {
+            render::scene_cache const cache(req.scene_path);
+            return served_scene{cache.get_materials(), cache.get_objects(),
+                                render::aos::scene(cache, accel)};
+          }
+          auto [materials, objects] = parseScene(req.scene_path, pool);
+          return render::reload_scene(previous, std::move(materials), std::move(objects),
+                                      [&](auto const & mats, auto const & objs) {
+                                        return render::aos::scene(mats, objs, accel);
+                                      });
+        });
+        int const width  = cfg.image_width;
+        int const height = render::image_height(cfg);
+        render::ppm_writer writer(out, width, height, format);
+        render::aos::render_image(
+            cfg, scn->scene, width, height, pool, [&](auto rows) { writer.write(rows); });
+        writer.finish();
+      };
+      render::serve(opts.serve, job, std::cout);
+    } catch (std::exception const & e) {
+      std::cerr << e.what() << "\n";
+      return 2;
     }
     return 0;
   }
 
-  std::vector<std::array<int, 3>> generate_gradient_image(Config const & cfg, int & width,
-                                                          int & height) {
-    width  = cfg.image_width;
-    height = (cfg.image_width * cfg.aspect_ratio.second) / cfg.aspect_ratio.first;
-    std::vector<std::array<int, 3>> pixels(static_cast<size_t>(width) *
-                                           static_cast<size_t>(height));
-    for (int y = 0; y < height; ++y) {
-      double t = (height == 1) ? 0.0 : double(y) / double(height - 1);
-      for (int x = 0; x < width; ++x) {
-        double rr = (1.0 - t) * cfg.background_light_color[0] + t * cfg.background_dark_color[0];
-        double gg = (1.0 - t) * cfg.background_light_color[1] + t * cfg.background_dark_color[1];
-        double bb = (1.0 - t) * cfg.background_light_color[2] + t * cfg.background_dark_color[2];
-        pixels[static_cast<size_t>(y) * static_cast<size_t>(width) + static_cast<size_t>(x)] = {
-          to_u8(rr, cfg.gamma), to_u8(gg, cfg.gamma), to_u8(bb, cfg.gamma)};
-      }
+  // Informe JSON de --stats; devuelve 3 si no se puede abrir el fichero, como la imagen
+  int write_stats(std::string const & path, render::run_report const & report) {
+    std::ofstream out(path);
+    if (!out) {
+      std::cerr << "Error: Could not open output file: " << path << "\n";
+      return 3;
     }
-    return pixels;
+    render::write_stats_json(out, report);
+    return 0;
   }
 
   int run(int argc, char ** argv) {
     std::span<char *> args(argv, static_cast<size_t>(argc));
-    int arg_status = validate_args(args);
+    render::options opts;
+    int arg_status = validate_args(args, opts);
     if (arg_status != 0) {
       return arg_status;
     }
+    if (not opts.compile_scene.empty()) {
+      return compile_scene(opts);
+    }
+    if (not opts.serve.empty()) {
+      return serve(opts);
+    }
 
-    std::string_view cfg_path   = args[1];
-    std::string_view scene_path = args[2];
-    std::string_view out_path   = args[3];
+    std::string_view cfg_path   = opts.positional[0];
+    std::string_view scene_path = opts.positional[1];
+    std::string_view out_path   = opts.positional[2];
 
     try {
-      Config cfg                = parseConfig(std::string(cfg_path));
-      auto [materials, objects] = parseScene(std::string(scene_path));
+      render::run_report report;
+      report.engine = "aos";
+      render::stopwatch const config_clock;
+      Config cfg                 = parseConfig(std::string(cfg_path));
+      report.phases.config_parse = config_clock.seconds();
+      // Fotogramas del modo por lotes (vacío si solo se pide una imagen)
+      std::vector<Config> const frames = render::batch_frames(opts, cfg);
+      // La opción --threads tiene prioridad sobre la clave threads: de la configuración
+      render::work_stealing_pool pool(
+          render::resolve_thread_count((opts.threads >= 0) ? opts.threads : cfg.threads));
+      auto const accel  = render::parse_accel(opts.accel);
+      auto const format = render::parse_ppm_format(opts.format);
+      render::aos::scene const scn =
+          load_scene(std::string(scene_path), accel, pool, report.phases);
 
-      int width = 0, height = 0;
-      auto pixels = generate_gradient_image(cfg, width, height);
+      // Una imagen completa: las franjas terminadas se escriben mientras se renderiza el resto.
+      // En el modo por lotes se llama una vez por fotograma con la misma escena y el mismo pool.
+      auto const render_frame = [&](Config const & frame, std::string const & path) {
+        int const width  = frame.image_width;
+        int const height = render::image_height(frame);
+        std::ofstream ofs(path, std::ios::binary);
+        if (!ofs) {
+          std::cerr << "Error: Could not open output file: " << path << "\n";
+          return 3;
+        }
+        render::render_stats frame_stats;
+        render::ppm_writer writer(ofs, width, height, format);
+        render::stopwatch const render_clock;
+        render::aos::render_image(
+            frame, scn, width, height, pool,
+            [&](auto rows) {
+              render::stopwatch const write_clock;
+              writer.write(rows);
+              report.phases.write += write_clock.seconds();
+            },
+            opts.stats.empty() ? nullptr : &frame_stats);
+        report.phases.render += render_clock.seconds();
+        report.render.merge(frame_stats);
+        render::stopwatch const finish_clock;
+        writer.finish();
+        report.phases.write += finish_clock.seconds();
+        std::cout << "Wrote " << path << " (" << width << "x" << height << ")\n";
+        return 0;
+      };
 
-      write_ppm(std::string(out_path), width, height, pixels);
-      std::cout << "Wrote " << out_path << " (" << width << "x" << height << ")\n";
+      int status = 0;
+      if (not frames.empty()) {
+        for (std::size_t k = 0; (k < frames.size()) and (status == 0); ++k) {
+          status = render_frame(frames[k], render::frame_path(std::string(out_path), k));
+        }
+      } else if (not opts.checkpoint.empty()) {
+        // Render progresivo: la imagen se reescribe con cada punto de control. La prueba de
+        // escritura abre en modo añadir para no vaciar la vista previa de un render reanudado
+        if (not std::ofstream(std::string(out_path), std::ios::binary | std::ios::app)) {
+          std::cerr << "Error: Could not open output file: " << out_path << "\n";
+          return 3;
+        }
+        int const width                    = cfg.image_width;
+        int const height                   = render::image_height(cfg);
+        render::render_stats * const stats = opts.stats.empty() ? nullptr : &report.render;
+        std::array const inputs = {std::string(cfg_path), std::string(scene_path)};
+        render::progress_state state(width, height, opts.pass_samples,
+                                     render::input_fingerprint(inputs));
+        render::progressive_job const job{opts.checkpoint, std::string(out_path), format,
+                                          opts.checkpoint_interval};
+        auto const pass = [&](render::progress_state & st) {
+          render::aos::render_pass(cfg, scn, st, pool, stats);
+        };
+        render::stopwatch const render_clock;
+        render::run_progressive(cfg, job, state, pass, std::cout);
+        report.phases.render = render_clock.seconds();
+        std::cout << "Wrote " << out_path << " (" << width << "x" << height << ")\n";
+      } else {
+        status = render_frame(cfg, std::string(out_path));
+      }
+      if (status != 0) {
+        return status;
+      }
+
+      if (not opts.stats.empty()) {
+        report.width     = cfg.image_width;
+        report.height    = render::image_height(cfg);
+        report.samples   = cfg.samples_per_pixel;
+        report.max_depth = cfg.max_depth;
+        return write_stats(opts.stats, report);
+      }
     } catch (std::exception const & e) {
       std::cerr << e.what() << "\n";
       return 2;
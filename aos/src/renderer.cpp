@@ -0,0 +1,156 @@
+#include "renderer.hpp"
+
+#include "camera.hpp"
+#include "color.hpp"
+#include "framebuffer.hpp"
+#include "sampling.hpp"
+#include "shading.hpp"
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <optional>
+
+namespace render::aos {
+
+  namespace {
+
+    // Bucle caliente: sigue un camino de hasta max_depth rebotes y devuelve su color.
+    // Cada rebote toma sus números del flujo (key, id, depth), sin estado entre rebotes.
+    template <typename Probe>
+    vector trace_path(scene const & scn, Config const & cfg, ray r, std::uint64_t key,
+                      sample_id id, Probe & probe) {
+      constexpr double infinity = std::numeric_limits<double>::infinity();
+      vector throughput{1.0, 1.0, 1.0};
+      for (int depth = 0; depth < cfg.max_depth; ++depth) {
+        hit_record rec;
+        if (not scn.closest_hit(r, min_hit_distance, infinity, rec, probe)) {
+          probe.path_end(depth + 1);
+          return throughput.hadamard(background(cfg, r));
+        }
+        rng_engine gen(key, id, static_cast<std::uint32_t>(depth));
+        scatter_result sr;
+        if (not scatter(scn.material_at(rec.material), r, rec, gen, sr)) {
+          probe.path_end(depth + 1);
+          return {};
+        }
+        throughput = throughput.hadamard(sr.attenuation);
+        r          = sr.scattered;
+      }
+      probe.path_end(cfg.max_depth);
+      return {};
+    }
+
+    // Muestrea los píxeles de una tesela: cada uno toma las muestras budget(pixel), se detiene
+    // antes si policy lo indica y store(pixel, est) recibe su estimación. Los desplazamientos
+    // de cada muestra salen de su propio flujo: la imagen no depende del reparto entre hilos.
+    template <typename Probe, typename Budget, typename Store>
+    void render_tile(Config const & cfg, scene const & scn, camera const & cam, tile const & tl,
+                     int width, sample_policy const & policy, Probe & probe, Budget const & budget,
+                     Store const & store) {
+      std::uint64_t const ray_key      = rng_key(cfg.ray_rng_seed);
+      std::uint64_t const material_key = rng_key(cfg.material_rng_seed);
+      for (int row = tl.row0; row < tl.row0 + tl.rows; ++row) {
+        for (int col = tl.col0; col < tl.col0 + tl.cols; ++col) {
+          auto const pixel = static_cast<std::size_t>(row) * static_cast<std::size_t>(width) +
+                             static_cast<std::size_t>(col);
+          sample_range const range = budget(pixel);
+          pixel_estimate est;
+          while (est.get_count() < range.count) {
+            sample_id const id{pixel, static_cast<std::uint32_t>(range.first + est.get_count())};
+            rng_engine ray_gen(ray_key, id, 0);
+            double const dx = ray_gen.uniform(-0.5, 0.5);
+            double const dy = ray_gen.uniform(-0.5, 0.5);
+            est.add(trace_path(scn, cfg, cam.primary_ray(row, col, dx, dy), material_key, id,
+                               probe));
+            if (policy.done(est)) {
+              break;
+            }
+          }
+          store(pixel, est);
+        }
+      }
+    }
+
+    // Reparte las teselas entre los hilos de pool; render(t, probe) procesa la tesela t. Con
+    // stats, la sonda cuenta rayos y se mide la ocupación de cada hilo.
+    template <typename Render>
+    void run_tiles(Config const & cfg, std::size_t tile_count, work_stealing_pool & pool,
+                   render_stats * stats, Render const & render) {
+      std::optional<tile_stats_sink> sink;
+      if (stats != nullptr) {
+        sink.emplace(*stats, cfg.max_depth, pool.size());
+      }
+      stopwatch const clock;
+      pool.run(tile_count, [&](std::size_t t) {
+        if (sink) {
+          stopwatch const tile_clock;
+          ray_stats probe(cfg.max_depth);
+          render(t, probe);
+          sink->add(probe, work_stealing_pool::current_worker(), tile_clock.seconds());
+        } else {
+          no_probe probe;
+          render(t, probe);
+        }
+      });
+      if (stats != nullptr) {
+        stats->render_seconds = clock.seconds();
+      }
+    }
+
+  }  // namespace
+
+  framebuffer render_image(Config const & cfg, scene const & scn, int width, int height,
+                           work_stealing_pool & pool, row_sink const & on_rows,
+                           render_stats * stats) {
+    camera const cam(cfg, width, height);
+    std::vector<tile> const tiles = make_tiles(width, height);
+
+    framebuffer image(width, height);
+    tone_mapper const mapper(cfg.gamma);
+    band_tracker progress(tiles, image, mapper, on_rows);
+    sample_policy const policy(cfg);
+    auto const budget = [&](std::size_t) { return sample_range{0, cfg.samples_per_pixel}; };
+    auto const store  = [&](std::size_t pixel, pixel_estimate const & est) {
+      image.set(pixel, est.mean());
+    };
+    run_tiles(cfg, tiles.size(), pool, stats, [&](std::size_t t, auto & probe) {
+      render_tile(cfg, scn, cam, tiles[t], width, policy, probe, budget, store);
+      progress.tile_done(t);
+    });
+    return image;
+  }
+
+  void render_pass(Config const & cfg, scene const & scn, progress_state & state,
+                   work_stealing_pool & pool, render_stats * stats) {
+    camera const cam(cfg, state.width, state.height);
+    std::vector<tile> const tiles = make_tiles(state.width, state.height);
+
+    // Las muestras de la pasada siguen a las ya acumuladas: sin muestreo adaptativo, la imagen
+    // final es la misma con cualquier tamaño de pasada
+    int const samples = state.pass_samples;
+    sample_policy const policy(samples);
+    sample_policy const target(cfg);
+    auto const budget = [&](std::size_t pixel) {
+      pixel_estimate const & acc = state.pixels[pixel];
+      int const taken            = acc.get_count();
+      int const count =
+          target.converged(acc) ? 0 : std::min(samples, cfg.samples_per_pixel - taken);
+      return sample_range{taken, count};
+    };
+    auto const store = [&](std::size_t pixel, pixel_estimate const & est) {
+      state.pixels[pixel].merge(est);
+    };
+    render_stats pass_stats;
+    run_tiles(cfg, tiles.size(), pool, (stats != nullptr) ? &pass_stats : nullptr,
+              [&](std::size_t t, auto & probe) {
+                render_tile(cfg, scn, cam, tiles[t], state.width, policy, probe, budget, store);
+              });
+    if (stats != nullptr) {
+      stats->merge(pass_stats);
+    }
+    ++state.passes_done;
+  }
+
+}  // namespace render::aos
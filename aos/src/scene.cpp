@@ -0,0 +1,217 @@
+#include "scene.hpp"
+
+#include <cstdint>
+#include <stdexcept>
+#include <string>
+#include <utility>
+
+namespace render::aos {
+
+  namespace {
+
+    // El parser ya resuelve el índice; se comprueba por si el objeto se construyó a mano
+    int material_index(std::vector<Material> const & materials, Object const & obj) {
+      if (obj.material_index >= materials.size()) {
+        throw std::runtime_error("Error: Invalid material index: [" +
+                                 std::to_string(obj.material_index) + "]");
+      }
+      return static_cast<int>(obj.material_index);
+    }
+
+    // Bucle de intersección de un solo tipo: closest se acorta con cada impacto y best señala
+    // el primitivo más cercano hasta el momento. Devuelve si alguno del tramo lo mejoró.
+    template <typename Shape>
+    bool closest_in(std::vector<Shape> const & shapes, std::size_t first, std::size_t last,
+                    ray const & r, double t_min, double & closest, Shape const *& best) {
+      bool found = false;
+      for (std::size_t i = first; i < last; ++i) {
+        double t = 0.0;
+        if (shapes[i].hit(r, t_min, closest, t)) {
+          closest = t;
+          best    = &shapes[i];
+          found   = true;
+        }
+      }
+      return found;
+    }
+
+    // Primitivos por hoja: pocos, porque se prueban uno a uno
+    constexpr std::size_t leaf_size = 4;
+
+  }  // namespace
+
+  scene::scene(std::vector<Material> const & mats, std::vector<Object> const & objects,
+               accel_kind accel) {
+    materials.reserve(mats.size());
+    for (auto const & mat : mats) {
+      materials.push_back(make_surface(mat));
+    }
+    sphere_prefix.reserve(objects.size() + 1);
+    sphere_prefix.push_back(0);
+    for (auto const & obj : objects) {
+      int const material = material_index(mats, obj);
+      if (obj.type == ObjectType::Sphere) {
+        spheres.push_back(make_shape<sphere_shape>(obj, material));
+      } else {
+        cylinders.push_back(make_shape<cylinder_shape>(obj, material));
+      }
+      sphere_prefix.push_back(static_cast<std::uint32_t>(spheres.size()));
+    }
+    if (accel == accel_kind::bvh) {
+      stopwatch const clock;
+      build_bvh();
+      bvh_seconds = clock.seconds();
+    }
+  }
+
+  scene::scene(scene_cache const & cache, accel_kind accel)
+      : scene(cache.get_materials(), cache.get_objects(), accel_kind::none) {
+    if (accel != accel_kind::bvh) {
+      return;
+    }
+    stopwatch const clock;
+    bvh const * const stored = cache.find_hierarchy(cached_bvh::aos);
+    if ((stored != nullptr) and (stored->get_order().size() == size())) {
+      use_bvh(*stored);
+    } else {
+      build_bvh();
+    }
+    bvh_seconds = clock.seconds();
+  }
+
+  std::size_t scene::size() const {
+    return spheres.size() + cylinders.size();
+  }
+
+  bool scene::is_sphere(std::size_t pos) const {
+    return sphere_prefix[pos + 1] != sphere_prefix[pos];
+  }
+
+  std::vector<aabb> scene::primitive_bounds() const {
+    std::vector<aabb> bounds;
+    bounds.reserve(size());
+    for (std::size_t i = 0; i < size(); ++i) {
+      std::size_t const s = sphere_prefix[i];
+      bounds.push_back(is_sphere(i) ? spheres[s].bounds() : cylinders[i - s].bounds());
+    }
+    return bounds;
+  }
+
+  void scene::build_bvh() {
+    use_bvh(bvh(primitive_bounds(), leaf_size));
+  }
+
+  void scene::use_bvh(bvh tree) {
+    hierarchy = std::move(tree);
+    std::vector<sphere_shape> ordered_spheres;
+    std::vector<cylinder_shape> ordered_cylinders;
+    std::vector<std::uint32_t> ordered_prefix;
+    ordered_spheres.reserve(spheres.size());
+    ordered_cylinders.reserve(cylinders.size());
+    ordered_prefix.reserve(sphere_prefix.size());
+    ordered_prefix.push_back(0);
+    for (std::uint32_t const idx : hierarchy.get_order()) {
+      std::size_t const s = sphere_prefix[idx];
+      if (is_sphere(idx)) {
+        ordered_spheres.push_back(spheres[s]);
+      } else {
+        ordered_cylinders.push_back(cylinders[idx - s]);
+      }
+      ordered_prefix.push_back(static_cast<std::uint32_t>(ordered_spheres.size()));
+    }
+    spheres       = std::move(ordered_spheres);
+    cylinders     = std::move(ordered_cylinders);
+    sphere_prefix = std::move(ordered_prefix);
+  }
+
+  void scene::update(std::vector<Material> const & mats, std::vector<Object> const & objects,
+                     scene_diff const & diff) {
+    for (std::uint32_t const m : diff.materials) {
+      materials[m] = make_surface(mats[m]);
+    }
+    if (diff.objects.empty()) {
+      return;
+    }
+    // Posición actual de cada objeto: los arrays siguen el orden de las hojas
+    std::vector<std::uint32_t> position;
+    if (not hierarchy.empty()) {
+      std::vector<std::uint32_t> const & order = hierarchy.get_order();
+      position.resize(order.size());
+      for (std::size_t pos = 0; pos < order.size(); ++pos) {
+        position[order[pos]] = static_cast<std::uint32_t>(pos);
+      }
+    }
+    for (std::uint32_t const idx : diff.objects) {
+      Object const & obj    = objects[idx];
+      int const material    = material_index(mats, obj);
+      std::size_t const pos = position.empty() ? idx : position[idx];
+      std::size_t const s   = sphere_prefix[pos];
+      if (is_sphere(pos)) {
+        spheres[s] = make_shape<sphere_shape>(obj, material);
+      } else {
+        cylinders[pos - s] = make_shape<cylinder_shape>(obj, material);
+      }
+    }
+    if (not hierarchy.empty()) {
+      stopwatch const clock;
+      hierarchy.refit(primitive_bounds());
+      bvh_seconds = clock.seconds();
+    }
+  }
+
+  bool scene::closest_hit(ray const & r, double t_min, double t_max, hit_record & rec) const {
+    no_probe probe;
+    return closest_hit(r, t_min, t_max, rec, probe);
+  }
+
+  template <typename Probe>
+  bool scene::closest_hit(ray const & r, double t_min, double t_max, hit_record & rec,
+                          Probe & probe) const {
+    double closest                  = t_max;
+    sphere_shape const * sphere     = nullptr;
+    cylinder_shape const * cylinder = nullptr;
+    bool cylinder_nearest           = false;
+    // Las posiciones [first, first + count) de la hoja son un tramo de cada array de tipo
+    auto const test_range = [&](std::size_t first, std::size_t count) {
+      probe.count_primitives(count);
+      std::size_t const last    = first + count;
+      std::size_t const s_first = sphere_prefix[first];
+      std::size_t const s_last  = sphere_prefix[last];
+      std::size_t const c_first = first - s_first;
+      std::size_t const c_last  = last - s_last;
+      if (closest_in(spheres, s_first, s_last, r, t_min, closest, sphere)) {
+        cylinder_nearest = false;
+      }
+      if (closest_in(cylinders, c_first, c_last, r, t_min, closest, cylinder)) {
+        cylinder_nearest = true;
+      }
+    };
+    if (hierarchy.empty()) {
+      test_range(0, size());
+    } else {
+      hierarchy.traverse(r, t_min, closest, test_range, probe);
+    }
+    if ((sphere == nullptr) and (cylinder == nullptr)) {
+      return false;
+    }
+
+    rec.t     = closest;
+    rec.point = r.at(closest);
+    if (cylinder_nearest) {
+      rec.normal   = cylinder->normal_at(rec.point);
+      rec.material = cylinder->material;
+    } else {
+      rec.normal   = sphere->normal_at(rec.point);
+      rec.material = sphere->material;
+    }
+    return true;
+  }
+
+  surface const & scene::material_at(int idx) const {
+    return materials[static_cast<size_t>(idx)];
+  }
+
+  template bool scene::closest_hit(ray const &, double, double, hit_record &, no_probe &) const;
+  template bool scene::closest_hit(ray const &, double, double, hit_record &, ray_stats &) const;
+
+}  // namespace render::aos
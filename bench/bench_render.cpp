@@ -0,0 +1,493 @@
+// bench/bench_render.cpp
+// Pruebas de rendimiento de render-aos y render-soa sobre escenas procedurales. Cada caso se
+// registra para los dos motores seguidos (y el recorrido por frentes de onda de render-soa), de
+// modo que la tabla los muestra lado a lado.
+#include "aos/include/renderer.hpp"
+#include "soa/include/renderer.hpp"
+#include "camera.hpp"
+#include "color.hpp"
+#include "framebuffer.hpp"
+#include "parser.hpp"
+#include "ppm.hpp"
+#include "rng.hpp"
+#include "scene_generator.hpp"
+#include "shapes.hpp"
+#include "stats.hpp"
+#include "thread_pool.hpp"
+#include "vector_pack.hpp"
+
+#include <benchmark/benchmark.h>
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <filesystem>
+#include <fstream>
+#include <limits>
+#include <map>
+#include <random>
+#include <streambuf>
+#include <string>
+#include <utility>
+#include <variant>
+#include <vector>
+
+namespace {
+
+  using scene_data = std::pair<std::vector<Material>, std::vector<Object>>;
+
+  // Hilos del render y del análisis: todos los núcleos
+  render::work_stealing_pool & shared_pool() {
+    static render::work_stealing_pool pool(render::resolve_thread_count(0));
+    return pool;
+  }
+
+  std::string write_temp(std::string const & name, std::string const & text) {
+    auto const path = (std::filesystem::temp_directory_path() / name).string();
+    std::ofstream(path, std::ios::binary) << text;
+    return path;
+  }
+
+  // Fichero de escena generado una sola vez por tamaño
+  std::string const & scene_file(std::size_t objects) {
+    static std::map<std::size_t, std::string> files;
+    auto [it, inserted] = files.try_emplace(objects);
+    if (inserted) {
+      render::bench::scene_spec const spec{.objects = objects};
+      it->second = write_temp("render_bench_" + std::to_string(objects) + ".txt",
+                              render::bench::generate_scene(spec));
+    }
+    return it->second;
+  }
+
+  scene_data const & scene_objects(std::size_t objects) {
+    static std::map<std::size_t, scene_data> scenes;
+    auto [it, inserted] = scenes.try_emplace(objects);
+    if (inserted) {
+      it->second = parseScene(scene_file(objects), shared_pool());
+    }
+    return it->second;
+  }
+
+  Config bench_config(std::size_t objects, render::bench::render_spec const & spec) {
+    render::bench::scene_spec const scene{.objects = objects};
+    return parseConfig(write_temp("render_bench_config.txt",
+                                  render::bench::generate_config(scene, spec)));
+  }
+
+  struct aos_engine {
+    using scene_type = render::aos::scene;
+
+    static scene_type build(scene_data const & data) { return {data.first, data.second}; }
+
+    static auto render(Config const & cfg, scene_type const & scn, int width, int height,
+                       render::render_stats * stats = nullptr) {
+      return render::aos::render_image(cfg, scn, width, height, shared_pool(), {}, stats);
+    }
+  };
+
+  struct soa_engine {
+    using scene_type = render::soa::scene;
+
+    static scene_type build(scene_data const & data) { return {data.first, data.second}; }
+
+    static auto render(Config const & cfg, scene_type const & scn, int width, int height,
+                       render::render_stats * stats = nullptr) {
+      return render::soa::render_image(cfg, scn, width, height, shared_pool(), {}, stats);
+    }
+  };
+
+  struct soa_wavefront_engine : soa_engine {
+    static auto render(Config const & cfg, scene_type const & scn, int width, int height,
+                       render::render_stats * stats = nullptr) {
+      return render::soa::render_image(cfg, scn, width, height, shared_pool(), {}, stats,
+                                       render::soa::integrator::wavefront);
+    }
+  };
+
+  // Núcleos de intersección en float (--precision=float)
+  struct soa_f32_engine : soa_engine {
+    static scene_type build(scene_data const & data) {
+      return {data.first, data.second, render::soa::simd_level::automatic,
+              render::accel_kind::bvh, render::soa::precision::f32};
+    }
+  };
+
+  // Construcción de la escena del motor (conversión de objetos y BVH)
+  template <typename Engine>
+  void build_scene(benchmark::State & state) {
+    auto const objects = static_cast<std::size_t>(state.range(0));
+    auto const & data  = scene_objects(objects);
+    for (auto _ : state) {
+      auto scn = Engine::build(data);
+      benchmark::DoNotOptimize(scn);
+    }
+    state.counters["objects/s"] = benchmark::Counter(
+        static_cast<double>(objects) * static_cast<double>(state.iterations()),
+        benchmark::Counter::kIsRate);
+  }
+
+  // Render completo: range(0) objetos, range(1) ancho, range(2) muestras, range(3) rebotes
+  template <typename Engine>
+  void render_scene(benchmark::State & state) {
+    auto const objects = static_cast<std::size_t>(state.range(0));
+    render::bench::render_spec const spec{static_cast<int>(state.range(1)),
+                                          static_cast<int>(state.range(2)),
+                                          static_cast<int>(state.range(3))};
+    Config const cfg = bench_config(objects, spec);
+    int const height = render::image_height(cfg);
+    auto const scn   = Engine::build(scene_objects(objects));
+
+    // Un render instrumentado fuera de la medida da los rayos de cada imagen: la imagen es
+    // determinista, así que todas las iteraciones trazan los mismos
+    render::render_stats stats;
+    Engine::render(cfg, scn, cfg.image_width, height, &stats);
+    auto const & rays = stats.rays;
+    for (auto _ : state) {
+      auto image = Engine::render(cfg, scn, cfg.image_width, height);
+      benchmark::DoNotOptimize(image);
+    }
+    auto const iterations = static_cast<double>(state.iterations());
+
+    state.counters["rays/s"] = benchmark::Counter(
+        static_cast<double>(rays.primary + rays.secondary) * iterations,
+        benchmark::Counter::kIsRate);
+    state.counters["primary/s"] = benchmark::Counter(static_cast<double>(rays.primary) * iterations,
+                                                     benchmark::Counter::kIsRate);
+  }
+
+  // Intersección por fuerza bruta de 256 rayos con range(0) objetos de una escena generada.
+  // Sin Typed, los primitivos van mezclados en un vector de std::variant y cada prueba pasa por
+  // std::visit; con él, un vector por tipo y un bucle instanciado para cada uno.
+  template <bool Typed>
+  void intersect_dispatch(benchmark::State & state) {
+    auto const objects = static_cast<std::size_t>(state.range(0));
+    auto const & data  = scene_objects(objects);
+    std::vector<std::variant<render::sphere_shape, render::cylinder_shape>> mixed;
+    std::vector<render::sphere_shape> spheres;
+    std::vector<render::cylinder_shape> cylinders;
+    for (auto const & obj : data.second) {
+      int const material = static_cast<int>(obj.material_index);
+      if (obj.type == ObjectType::Sphere) {
+        spheres.push_back(render::make_shape<render::sphere_shape>(obj, material));
+        mixed.emplace_back(spheres.back());
+      } else {
+        cylinders.push_back(render::make_shape<render::cylinder_shape>(obj, material));
+        mixed.emplace_back(cylinders.back());
+      }
+    }
+    std::mt19937 gen(11);
+    std::uniform_real_distribution<double> dir(-1.0, 1.0);
+    std::vector<render::ray> rays;
+    for (int i = 0; i < 256; ++i) {
+      rays.push_back({
+        {0.0, 0.0, 0.0},
+        render::vector{dir(gen), dir(gen), dir(gen)}.normalized()
+      });
+    }
+
+    auto const closest_in = [](auto const & shapes, render::ray const & r, double & closest) {
+      for (auto const & shape : shapes) {
+        double t = 0.0;
+        if (shape.hit(r, render::min_hit_distance, closest, t)) {
+          closest = t;
+        }
+      }
+    };
+    for (auto _ : state) {
+      for (auto const & r : rays) {
+        double closest = std::numeric_limits<double>::infinity();
+        if constexpr (Typed) {
+          closest_in(spheres, r, closest);
+          closest_in(cylinders, r, closest);
+        } else {
+          for (auto const & shape : mixed) {
+            std::visit(
+                [&](auto const & s) {
+                  double t = 0.0;
+                  if (s.hit(r, render::min_hit_distance, closest, t)) {
+                    closest = t;
+                  }
+                },
+                shape);
+          }
+        }
+        benchmark::DoNotOptimize(closest);
+      }
+    }
+    state.counters["tests/s"] = benchmark::Counter(
+        static_cast<double>(rays.size() * objects) * static_cast<double>(state.iterations()),
+        benchmark::Counter::kIsRate);
+  }
+
+  // Producto escalar y módulo del producto vectorial de pares de vectores, uno a uno o en
+  // bloques de 8 lanes con vector3_pack
+  template <bool Packed>
+  void vector_math(benchmark::State & state) {
+    constexpr std::size_t count = 4096;
+    constexpr std::size_t lanes = 8;
+    std::mt19937 gen(5);
+    std::uniform_real_distribution<double> coord(-1.0, 1.0);
+    std::vector<render::vector> a(count);
+    std::vector<render::vector> b(count);
+    std::vector<render::vector3_pack<lanes>> pa(count / lanes);
+    std::vector<render::vector3_pack<lanes>> pb(count / lanes);
+    for (std::size_t i = 0; i < count; ++i) {
+      a[i] = {coord(gen), coord(gen), coord(gen)};
+      b[i] = {coord(gen), coord(gen), coord(gen)};
+      pa[i / lanes].set_lane(i % lanes, a[i]);
+      pb[i / lanes].set_lane(i % lanes, b[i]);
+    }
+
+    std::vector<double> out(count);
+    for (auto _ : state) {
+      if constexpr (Packed) {
+        for (std::size_t k = 0; k < pa.size(); ++k) {
+          auto const dots  = pa[k].dot(pb[k]);
+          auto const areas = pa[k].cross(pb[k]).squared_magnitude();
+          for (std::size_t i = 0; i < lanes; ++i) {
+            out[k * lanes + i] = dots[i] + areas[i];
+          }
+        }
+      } else {
+        for (std::size_t i = 0; i < count; ++i) {
+          out[i] = a[i].dot(b[i]) + a[i].cross(b[i]).squared_magnitude();
+        }
+      }
+      benchmark::DoNotOptimize(out.data());
+      benchmark::ClobberMemory();
+    }
+    state.counters["vectors/s"] = benchmark::Counter(
+        static_cast<double>(count) * static_cast<double>(state.iterations()),
+        benchmark::Counter::kIsRate);
+  }
+
+  void parse_scene(benchmark::State & state) {
+    auto const objects       = static_cast<std::size_t>(state.range(0));
+    std::string const & path = scene_file(objects);
+    auto const bytes         = std::filesystem::file_size(path);
+    for (auto _ : state) {
+      auto data = parseScene(path, shared_pool());
+      benchmark::DoNotOptimize(data);
+    }
+    state.SetBytesProcessed(static_cast<std::int64_t>(bytes) * state.iterations());
+  }
+
+  // Flujo que descarta lo escrito y solo cuenta los bytes: mide el formateo del PPM
+  class counting_buffer : public std::streambuf {
+  public:
+    [[nodiscard]] std::int64_t size() const { return count; }
+
+  protected:
+    std::streamsize xsputn(char const *, std::streamsize n) override {
+      count += n;
+      return n;
+    }
+
+    int_type overflow(int_type c) override {
+      ++count;
+      return traits_type::not_eof(c);
+    }
+
+  private:
+    std::int64_t count = 0;
+  };
+
+  void write_ppm(benchmark::State & state, render::ppm_format format) {
+    int const width  = static_cast<int>(state.range(0));
+    int const height = width * 9 / 16;
+    std::mt19937 gen(5);
+    std::uniform_int_distribution<int> channel(0, 255);
+    std::vector<render::rgb8> pixels(static_cast<std::size_t>(width) *
+                                     static_cast<std::size_t>(height));
+    for (auto & p : pixels) {
+      for (auto & v : p) {
+        v = static_cast<std::uint8_t>(channel(gen));
+      }
+    }
+
+    counting_buffer sink;
+    std::ostream out(&sink);
+    for (auto _ : state) {
+      render::ppm_writer writer(out, width, height, format);
+      writer.write(pixels);
+      writer.finish();
+    }
+    state.SetBytesProcessed(sink.size());
+  }
+
+  // Corrección gamma y cuantización de una imagen de colores lineales
+  template <bool Table>
+  void tone_map(benchmark::State & state) {
+    int const width  = static_cast<int>(state.range(0));
+    int const height = width * 9 / 16;
+    std::mt19937 gen(7);
+    std::uniform_real_distribution<double> channel(0.0, 1.0);
+    render::framebuffer image(width, height);
+    std::vector<render::rgb8> pixels(image.index(height, 0));
+    for (std::size_t i = 0; i < pixels.size(); ++i) {
+      image.set(i, {channel(gen), channel(gen), channel(gen)});
+    }
+
+    double const gamma = 2.2;
+    for (auto _ : state) {
+      if constexpr (Table) {
+        render::tone_mapper const mapper(gamma);
+        image.pack_rows(0, height, mapper, pixels);
+      } else {
+        for (std::size_t i = 0; i < pixels.size(); ++i) {
+          auto const c = render::to_rgb8(image.get(i), gamma);
+          pixels[i]    = {static_cast<std::uint8_t>(c[0]), static_cast<std::uint8_t>(c[1]),
+                          static_cast<std::uint8_t>(c[2])};
+        }
+      }
+      benchmark::DoNotOptimize(pixels.data());
+    }
+    state.counters["pixels/s"] = benchmark::Counter(
+        static_cast<double>(pixels.size()) * static_cast<double>(state.iterations()),
+        benchmark::Counter::kIsRate);
+  }
+
+  // Números aleatorios de una tesela de 16x16 píxeles con 4 muestras: dos desplazamientos por
+  // rayo primario y tres por rebote, los de la dispersión. range(0) rebotes. Sin Counter, dos
+  // mt19937_64 por tesela y std::uniform_real_distribution, como antes; con él, un flujo
+  // Philox por muestra y rebote.
+  template <bool Counter>
+  void rng_cost(benchmark::State & state) {
+    int const depth                  = static_cast<int>(state.range(0));
+    std::uint32_t const spp          = 4;
+    std::size_t const pixels         = 16 * 16;
+    std::uint64_t const ray_key      = render::rng_key(1);
+    std::uint64_t const material_key = render::rng_key(2);
+    std::uint64_t tile               = 0;
+    double sink                      = 0.0;
+    for (auto _ : state) {
+      if constexpr (Counter) {
+        for (std::size_t p = 0; p < pixels; ++p) {
+          for (std::uint32_t s = 0; s < spp; ++s) {
+            render::sample_id const id{tile * pixels + p, s};
+            render::rng_engine ray_gen(ray_key, id, 0);
+            sink += ray_gen.uniform(-0.5, 0.5) + ray_gen.uniform(-0.5, 0.5);
+            for (int d = 0; d < depth; ++d) {
+              render::rng_engine gen(material_key, id, static_cast<std::uint32_t>(d));
+              sink += gen.uniform(-1.0, 1.0) + gen.uniform(-1.0, 1.0) + gen.uniform(-1.0, 1.0);
+            }
+          }
+        }
+      } else {
+        std::uniform_real_distribution<double> jitter(-0.5, 0.5);
+        std::uniform_real_distribution<double> unit(-1.0, 1.0);
+        std::mt19937_64 ray_gen(ray_key + tile);
+        std::mt19937_64 material_gen(material_key + tile);
+        for (std::size_t i = 0; i < pixels * spp; ++i) {
+          sink += jitter(ray_gen) + jitter(ray_gen);
+          for (int d = 0; d < depth; ++d) {
+            sink += unit(material_gen) + unit(material_gen) + unit(material_gen);
+          }
+        }
+      }
+      ++tile;
+      benchmark::DoNotOptimize(sink);
+    }
+    state.counters["rays/s"] = benchmark::Counter(
+        static_cast<double>(pixels * spp) * static_cast<double>(state.iterations()),
+        benchmark::Counter::kIsRate);
+  }
+
+  void register_benchmarks() {
+    std::vector<std::int64_t> const sizes = {10, 100, 1'000, 10'000, 100'000, 1'000'000};
+    for (auto const n : sizes) {
+      // Tiempo real: el análisis reparte el trabajo entre los hilos del pool
+      benchmark::RegisterBenchmark("parse", parse_scene)
+          ->Arg(n)
+          ->Unit(benchmark::kMillisecond)
+          ->UseRealTime();
+    }
+    for (auto const n : sizes) {
+      benchmark::RegisterBenchmark("build/aos", build_scene<aos_engine>)
+          ->Arg(n)
+          ->Unit(benchmark::kMillisecond);
+      benchmark::RegisterBenchmark("build/soa", build_scene<soa_engine>)
+          ->Arg(n)
+          ->Unit(benchmark::kMillisecond);
+    }
+
+    for (auto const n : {100, 1'000}) {
+      benchmark::RegisterBenchmark("intersect/variant", intersect_dispatch<false>)->Arg(n);
+      benchmark::RegisterBenchmark("intersect/typed", intersect_dispatch<true>)->Arg(n);
+    }
+    benchmark::RegisterBenchmark("vector/scalar", vector_math<false>);
+    benchmark::RegisterBenchmark("vector/pack", vector_math<true>);
+
+    // Objetos, ancho, muestras y rebotes
+    std::vector<std::array<std::int64_t, 4>> const renders = {
+      {10,        128, 4, 5},
+      {1'000,     128, 4, 5},
+      {100'000,   128, 4, 5},
+      {1'000'000, 128, 4, 5},
+      {1'000,     64,  1, 1},
+      {1'000,     256, 1, 5},
+      {1'000,     128, 16, 5},
+      {1'000,     128, 4, 20},
+    };
+    for (auto const & r : renders) {
+      std::vector<std::int64_t> const args(r.begin(), r.end());
+      benchmark::RegisterBenchmark("render/aos", render_scene<aos_engine>)
+          ->Args(args)
+          ->ArgNames({"objects", "width", "spp", "depth"})
+          ->Unit(benchmark::kMillisecond)
+          ->UseRealTime();
+      benchmark::RegisterBenchmark("render/soa", render_scene<soa_engine>)
+          ->Args(args)
+          ->ArgNames({"objects", "width", "spp", "depth"})
+          ->Unit(benchmark::kMillisecond)
+          ->UseRealTime();
+      benchmark::RegisterBenchmark("render/soa-wavefront", render_scene<soa_wavefront_engine>)
+          ->Args(args)
+          ->ArgNames({"objects", "width", "spp", "depth"})
+          ->Unit(benchmark::kMillisecond)
+          ->UseRealTime();
+      benchmark::RegisterBenchmark("render/soa-f32", render_scene<soa_f32_engine>)
+          ->Args(args)
+          ->ArgNames({"objects", "width", "spp", "depth"})
+          ->Unit(benchmark::kMillisecond)
+          ->UseRealTime();
+    }
+
+    // La tabla incluye su construcción en cada iteración, como en un render
+    for (auto const width : {320, 3'840}) {
+      benchmark::RegisterBenchmark("tone/pow", tone_map<false>)
+          ->Arg(width)
+          ->Unit(benchmark::kMillisecond);
+      benchmark::RegisterBenchmark("tone/table", tone_map<true>)
+          ->Arg(width)
+          ->Unit(benchmark::kMillisecond);
+    }
+
+    for (auto const depth : {1, 5, 20}) {
+      benchmark::RegisterBenchmark("rng/mt19937_64", rng_cost<false>)->Arg(depth);
+      benchmark::RegisterBenchmark("rng/philox", rng_cost<true>)->Arg(depth);
+    }
+
+    for (auto const width : {320, 1'920}) {
+      benchmark::RegisterBenchmark("ppm/p3", write_ppm, render::ppm_format::p3)
+          ->Arg(width)
+          ->Unit(benchmark::kMillisecond);
+      benchmark::RegisterBenchmark("ppm/p6", write_ppm, render::ppm_format::p6)
+          ->Arg(width)
+          ->Unit(benchmark::kMillisecond);
+    }
+  }
+
+}  // namespace
+
+int main(int argc, char ** argv) {
+  benchmark::Initialize(&argc, argv);
+  if (benchmark::ReportUnrecognizedArguments(argc, argv)) {
+    return 1;
+  }
+  register_benchmarks();
+  benchmark::RunSpecifiedBenchmarks();
+  benchmark::Shutdown();
+  return 0;
+}
@@ -0,0 +1,130 @@
+// bench/precision_check.cpp
+// Renderiza una escena con render-soa en double y en float y compara las dos imágenes de 8 bits
+#include "soa/include/renderer.hpp"
+#include "camera.hpp"
+#include "color.hpp"
+#include "parser.hpp"
+#include "ppm.hpp"
+#include "stats.hpp"
+#include "thread_pool.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <cstdlib>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <limits>
+#include <span>
+#include <string>
+#include <vector>
+
+namespace {
+
+  struct image_diff {
+    std::size_t pixels    = 0;
+    std::size_t differing = 0;  // píxeles con algún canal distinto
+    int max_channel       = 0;  // mayor diferencia absoluta en un canal, 0..255
+    double mean_abs       = 0.0;
+    double psnr           = std::numeric_limits<double>::infinity();  // dB, pico 255
+  };
+
+  image_diff compare(std::vector<render::rgb8> const & a, std::vector<render::rgb8> const & b) {
+    image_diff d;
+    d.pixels              = a.size();
+    std::uint64_t abs_sum = 0;
+    std::uint64_t sq_sum  = 0;
+    for (std::size_t i = 0; i < a.size(); ++i) {
+      bool differs = false;
+      for (std::size_t c = 0; c < 3; ++c) {
+        int const delta = std::abs(int{a[i][c]} - int{b[i][c]});
+        differs         = differs or (delta != 0);
+        d.max_channel   = std::max(d.max_channel, delta);
+        abs_sum += static_cast<std::uint64_t>(delta);
+        sq_sum += static_cast<std::uint64_t>(delta * delta);
+      }
+      d.differing += differs ? 1U : 0U;
+    }
+    double const samples = 3.0 * static_cast<double>(a.size());
+    d.mean_abs           = static_cast<double>(abs_sum) / samples;
+    if (sq_sum > 0) {
+      double const mse = static_cast<double>(sq_sum) / samples;
+      d.psnr           = 10.0 * std::log10(255.0 * 255.0 / mse);
+    }
+    return d;
+  }
+
+  // Diferencia por píxel en gris, amplificada 16 veces para que se vea
+  void write_diff(std::string const & path, int width, int height,
+                  std::vector<render::rgb8> const & a, std::vector<render::rgb8> const & b) {
+    std::vector<render::rgb8> out(a.size());
+    for (std::size_t i = 0; i < a.size(); ++i) {
+      int delta = 0;
+      for (std::size_t c = 0; c < 3; ++c) {
+        delta = std::max(delta, std::abs(int{a[i][c]} - int{b[i][c]}));
+      }
+      auto const v = static_cast<std::uint8_t>(std::min(255, delta * 16));
+      out[i]       = {v, v, v};
+    }
+    std::ofstream file(path, std::ios::binary);
+    render::ppm_writer writer(file, width, height, render::ppm_format::p6);
+    writer.write(out);
+    writer.finish();
+  }
+
+  std::vector<render::rgb8> render_with(Config const & cfg, render::soa::scene const & scn,
+                                        render::work_stealing_pool & pool, double & seconds) {
+    int const width  = cfg.image_width;
+    int const height = render::image_height(cfg);
+    render::stopwatch const clock;
+    auto const image = render::soa::render_image(cfg, scn, width, height, pool);
+    seconds          = clock.seconds();
+    return image.pack(render::tone_mapper(cfg.gamma));
+  }
+
+}  // namespace
+
+int main(int argc, char ** argv) {
+  std::span<char *> const args(argv, static_cast<std::size_t>(argc));
+  if ((args.size() != 3) and (args.size() != 4)) {
+    std::cerr << "Usage: precision-check <config.txt> <scene.txt> [diff.ppm]\n";
+    return 1;
+  }
+  try {
+    Config const cfg = parseConfig(args[1]);
+    render::work_stealing_pool pool(render::resolve_thread_count(cfg.threads));
+    auto const [materials, objects] = parseScene(args[2], pool);
+    render::soa::scene const wide(materials, objects, render::soa::simd_level::automatic,
+                                  render::accel_kind::bvh, render::soa::precision::f64);
+    render::soa::scene const narrow(materials, objects, render::soa::simd_level::automatic,
+                                    render::accel_kind::bvh, render::soa::precision::f32);
+
+    double wide_seconds   = 0.0;
+    double narrow_seconds = 0.0;
+    auto const reference  = render_with(cfg, wide, pool, wide_seconds);
+    auto const candidate  = render_with(cfg, narrow, pool, narrow_seconds);
+    image_diff const d    = compare(reference, candidate);
+
+    std::cout << std::fixed << std::setprecision(3);
+    std::cout << "simd:           " << render::soa::simd_level_name(wide.get_simd_level())
+              << "\n"
+              << "double:         " << wide_seconds << " s\n"
+              << "float:          " << narrow_seconds << " s ("
+              << (wide_seconds / narrow_seconds) << "x)\n"
+              << "pixels:         " << d.pixels << "\n"
+              << "differing:      " << d.differing << " ("
+              << 100.0 * static_cast<double>(d.differing) / static_cast<double>(d.pixels)
+              << " %)\n"
+              << "max channel:    " << d.max_channel << "\n"
+              << "mean abs:       " << d.mean_abs << "\n"
+              << "psnr:           " << d.psnr << " dB\n";
+    if (args.size() == 4) {
+      write_diff(args[3], cfg.image_width, render::image_height(cfg), reference, candidate);
+    }
+  } catch (std::exception const & e) {
+    std::cerr << e.what() << "\n";
+    return 2;
+  }
+  return 0;
+}
@@ -0,0 +1,45 @@
+// bench/scene_gen.cpp
+// Genera una escena procedural y su configuración para probar los binarios de render
+#include "scene_generator.hpp"
+
+#include <charconv>
+#include <fstream>
+#include <iostream>
+#include <span>
+#include <string>
+
+namespace {
+
+  bool write_file(std::string const & path, std::string const & text) {
+    std::ofstream out(path, std::ios::binary);
+    out << text;
+    return static_cast<bool>(out);
+  }
+
+  bool parse_size(std::string const & text, std::size_t & value) {
+    auto const last      = text.data() + text.size();
+    auto const [ptr, ec] = std::from_chars(text.data(), last, value);
+    return (ec == std::errc{}) and (ptr == last);
+  }
+
+}  // namespace
+
+int main(int argc, char ** argv) {
+  std::span<char *> const args(argv, static_cast<std::size_t>(argc));
+  if (args.size() != 4) {
+    std::cerr << "Usage: scene-gen <objects> <config.txt> <scene.txt>\n";
+    return 1;
+  }
+  render::bench::scene_spec scene;
+  if (not parse_size(args[1], scene.objects)) {
+    std::cerr << "Error: Invalid number of objects: " << args[1] << "\n";
+    return 1;
+  }
+  if (not write_file(args[2], render::bench::generate_config(scene, {})) or
+      not write_file(args[3], render::bench::generate_scene(scene))) {
+    std::cerr << "Error: Could not write output files\n";
+    return 3;
+  }
+  std::cout << "Wrote " << args[3] << " (" << scene.objects << " objects)\n";
+  return 0;
+}
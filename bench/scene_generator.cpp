@@ -0,0 +1,112 @@
+#include "scene_generator.hpp"
+
+#include <algorithm>
+#include <array>
+#include <charconv>
+#include <cmath>
+#include <random>
+
+namespace render::bench {
+
+  namespace {
+
+    // Número con cuatro decimales, sin depender de la configuración regional
+    void append(std::string & out, double value) {
+      std::array<char, 32> buf{};
+      auto const [ptr, ec] =
+          std::to_chars(buf.data(), buf.data() + buf.size(), value, std::chars_format::fixed, 4);
+      out.push_back(' ');
+      out.append(buf.data(), ec == std::errc{} ? ptr : buf.data());
+    }
+
+    void append_material(std::string & out, std::size_t idx) {
+      out += " m";
+      out += std::to_string(idx);
+    }
+
+    // Lado del cubo que contiene los objetos
+    double scene_extent(std::size_t objects) {
+      return 4.0 * std::cbrt(static_cast<double>(std::max<std::size_t>(objects, 1)));
+    }
+
+  }  // namespace
+
+  std::string generate_scene(scene_spec const & spec) {
+    std::mt19937_64 gen(spec.seed);
+    std::uniform_real_distribution<double> unit(0.0, 1.0);
+    std::size_t const material_count = std::max<std::size_t>(spec.materials, 1);
+
+    std::string out;
+    out.reserve(spec.objects * 48 + material_count * 40);
+    for (std::size_t i = 0; i < material_count; ++i) {
+      switch (i % 3) {
+        case 0:
+          out += "matte:";
+          append_material(out, i);
+          append(out, 0.2 + 0.7 * unit(gen));
+          append(out, 0.2 + 0.7 * unit(gen));
+          append(out, 0.2 + 0.7 * unit(gen));
+          break;
+        case 1:
+          out += "metal:";
+          append_material(out, i);
+          append(out, 0.5 + 0.5 * unit(gen));
+          append(out, 0.5 + 0.5 * unit(gen));
+          append(out, 0.5 + 0.5 * unit(gen));
+          append(out, 0.3 * unit(gen));
+          break;
+        default:
+          out += "refractive:";
+          append_material(out, i);
+          append(out, 1.3 + 0.4 * unit(gen));
+          break;
+      }
+      out.push_back('\n');
+    }
+
+    double const half = scene_extent(spec.objects) / 2.0;
+    std::uniform_real_distribution<double> pos(-half, half);
+    std::uniform_real_distribution<double> dir(-1.0, 1.0);
+    std::uniform_int_distribution<std::size_t> pick(0, material_count - 1);
+    for (std::size_t i = 0; i < spec.objects; ++i) {
+      double const x = pos(gen);
+      double const y = pos(gen);
+      double const z = pos(gen);
+      if (unit(gen) < spec.cylinders) {
+        out += "cylinder:";
+        append(out, x);
+        append(out, y);
+        append(out, z);
+        append(out, 0.1 + 0.3 * unit(gen));
+        // El eje nunca es nulo: la componente y se aleja de cero
+        append(out, dir(gen));
+        append(out, 0.5 + unit(gen));
+        append(out, dir(gen));
+      } else {
+        out += "sphere:";
+        append(out, x);
+        append(out, y);
+        append(out, z);
+        append(out, 0.2 + 0.4 * unit(gen));
+      }
+      append_material(out, pick(gen));
+      out.push_back('\n');
+    }
+    return out;
+  }
+
+  std::string generate_config(scene_spec const & scene, render_spec const & render) {
+    double const extent = scene_extent(scene.objects);
+    std::string out     = "image_width: " + std::to_string(render.width) + "\n";
+    out += "camera_position: 0";
+    append(out, 0.3 * extent);
+    append(out, -1.6 * extent);
+    out += "\ncamera_target: 0 0 0\n";
+    out += "camera_north: 0 1 0\n";
+    out += "field_of_view: 45\n";
+    out += "samples_per_pixel: " + std::to_string(render.samples) + "\n";
+    out += "max_depth: " + std::to_string(render.depth) + "\n";
+    return out;
+  }
+
+}  // namespace render::bench
@@ -0,0 +1,34 @@
+#ifndef RENDER_BENCH_SCENE_GENERATOR_HPP
+#define RENDER_BENCH_SCENE_GENERATOR_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+
+namespace render::bench {
+
+  // Parámetros de una escena procedural
+  struct scene_spec {
+    std::size_t objects   = 1'000;  // esferas y cilindros
+    std::size_t materials = 12;     // a partes iguales mate, metal y refractivo
+    double cylinders      = 0.25;   // fracción de cilindros
+    std::uint64_t seed    = 1;
+  };
+
+  // Parámetros de render de una prueba
+  struct render_spec {
+    int width   = 128;
+    int samples = 4;
+    int depth   = 5;
+  };
+
+  // Texto de escena con los objetos repartidos al azar en un cubo cuyo lado crece con la raíz
+  // cúbica del número de objetos, para que la densidad sea parecida a cualquier escala
+  std::string generate_scene(scene_spec const & spec);
+
+  // Texto de configuración con la cámara encuadrando la escena de generate_scene
+  std::string generate_config(scene_spec const & scene, render_spec const & render);
+
+}  // namespace render::bench
+
+#endif
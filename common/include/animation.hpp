@@ -0,0 +1,36 @@
+#ifndef RENDER_ANIMATION_HPP
+#define RENDER_ANIMATION_HPP
+
+#include "options.hpp"
+#include "parser.hpp"
+
+#include <cstddef>
+#include <string>
+#include <vector>
+
+namespace render {
+
+  // Modo por lotes: varios fotogramas de la misma escena en un solo proceso. La escena, su
+  // estructura de aceleración y el pool de hilos se crean una vez y se reutilizan; cada
+  // fotograma solo cambia la configuración (cámara, muestras, tamaño...).
+
+  // Lee un fichero de fotogramas. Cada línea "frame:" empieza un fotograma que parte del
+  // anterior y aplica las claves de configuración que le siguen; las claves previas al primer
+  // "frame:" valen para todos. Lanza std::runtime_error si no hay ningún fotograma o si una
+  // clave no es válida (mismos mensajes que parseConfig).
+  std::vector<Config> load_frames(Config const & base, std::string const & path);
+
+  // count fotogramas con la cámara dando una vuelta completa alrededor de camera_target, sobre
+  // el eje camera_north y a la distancia y altura de base. El primero es base.
+  std::vector<Config> turntable_frames(Config const & base, int count);
+
+  // Fotogramas pedidos con --frames o --turntable; vacío si no se pide el modo por lotes
+  std::vector<Config> batch_frames(options const & opts, Config const & base);
+
+  // Nombre del fotograma frame (desde 0): la primera racha de '#' del patrón se sustituye por
+  // el número con ceros a la izquierda hasta su longitud. Lanza si el patrón no tiene '#'.
+  std::string frame_path(std::string const & pattern, std::size_t frame);
+
+}  // namespace render
+
+#endif
@@ -0,0 +1,146 @@
+#ifndef RENDER_BVH_HPP
+#define RENDER_BVH_HPP
+
+#include "ray.hpp"
+#include "stats.hpp"
+#include "vector.hpp"
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace render {
+
+  // Estructura de aceleración usada en la búsqueda de intersecciones
+  enum class accel_kind { none, bvh };
+
+  // Lanza std::runtime_error si el nombre no corresponde a ninguna estructura
+  accel_kind parse_accel(std::string const & name);
+
+  // Caja alineada con los ejes
+  struct aabb {
+    std::array<double, 3> lo;
+    std::array<double, 3> hi;
+
+    void expand(aabb const & other);
+    [[nodiscard]] double surface_area() const;
+  };
+
+  aabb sphere_bounds(vector const & center, double radius);
+  aabb cylinder_bounds(vector const & center, double radius, vector const & axis,
+                       double half_height);
+
+  // Rayo preparado para el test de caja: inversa de la dirección precalculada
+  struct bvh_ray {
+    std::array<double, 3> origin;
+    std::array<double, 3> inv_dir;
+    std::array<bool, 3> negative;
+
+    explicit bvh_ray(ray const & r);
+  };
+
+  // Nodo aplanado en orden de profundidad: el hijo izquierdo de un nodo interior es el
+  // siguiente nodo del array y el derecho está en 'offset'. Un nodo ocupa una línea de caché.
+  struct alignas(64) bvh_node {
+    std::array<double, 3> lo;
+    std::array<double, 3> hi;
+    std::uint32_t offset;  // hoja: primer primitivo; interior: índice del hijo derecho
+    std::uint16_t count;   // primitivos de la hoja (0 en nodos interiores)
+    std::uint16_t axis;    // eje de partición, para visitar antes el hijo más cercano
+
+    // Intersección del rayo con la caja en [t_min, t_max]
+    [[nodiscard]] bool hit(bvh_ray const & r, double t_min, double t_max) const {
+      double t0 = t_min;
+      double t1 = t_max;
+      for (std::size_t k = 0; k < 3; ++k) {
+        double near = (lo[k] - r.origin[k]) * r.inv_dir[k];
+        double far  = (hi[k] - r.origin[k]) * r.inv_dir[k];
+        if (r.negative[k]) {
+          std::swap(near, far);
+        }
+        // Escritas así para que un NaN (origen en el plano y dirección paralela) no descarte
+        t0 = (near > t0) ? near : t0;
+        t1 = (far < t1) ? far : t1;
+      }
+      return t0 <= t1;
+    }
+  };
+
+  // Jerarquía de volúmenes envolventes construida con SAH por intervalos (binned SAH).
+  // La construcción devuelve la permutación de los primitivos: el llamante los reordena para
+  // que cada hoja sea un rango contiguo [offset, offset + count).
+  class bvh {
+  public:
+    bvh() = default;
+    bvh(std::vector<aabb> const & bounds, std::size_t max_leaf_size);
+    // Reconstruye una jerarquía ya construida (escena compilada). Lanza std::runtime_error si
+    // algún nodo apunta fuera de los arrays o supera la profundidad máxima del recorrido.
+    bvh(std::vector<bvh_node> flat_nodes, std::vector<std::uint32_t> leaf_order);
+
+    [[nodiscard]] bool empty() const { return nodes.empty(); }
+
+    // Recalcula las cajas de todos los nodos sin cambiar la topología, tras mover o
+    // redimensionar primitivos. bounds[i] es la caja del primitivo en la posición i del orden
+    // de las hojas (no la original). Es lineal en el número de nodos, pero la jerarquía solo
+    // conserva su calidad si los cambios son pequeños.
+    void refit(std::vector<aabb> const & bounds);
+
+    [[nodiscard]] std::vector<bvh_node> const & get_nodes() const { return nodes; }
+
+    // order[i] es el índice original del primitivo que ocupa la posición i
+    [[nodiscard]] std::vector<std::uint32_t> const & get_order() const { return order; }
+
+    // Recorrido con pila explícita. leaf(first, count) prueba los primitivos de una hoja y
+    // actualiza closest; los nodos más lejanos que closest se descartan.
+    template <typename Leaf>
+    void traverse(ray const & r, double t_min, double const & closest, Leaf && leaf) const {
+      no_probe probe;
+      traverse(r, t_min, closest, std::forward<Leaf>(leaf), probe);
+    }
+
+    // Igual que la anterior, contando en probe cada nodo cuya caja se prueba
+    template <typename Leaf, typename Probe>
+    void traverse(ray const & r, double t_min, double const & closest, Leaf && leaf,
+                  Probe & probe) const {
+      if (nodes.empty()) {
+        return;
+      }
+      bvh_ray const br(r);
+      std::array<std::uint32_t, max_depth + 2> stack{};
+      std::size_t top = 0;
+      stack[top++]    = 0;
+      while (top > 0) {
+        std::uint32_t const idx = stack[--top];
+        bvh_node const & node   = nodes[idx];
+        probe.count_box();
+        if (not node.hit(br, t_min, closest)) {
+          continue;
+        }
+        if (node.count > 0) {
+          leaf(static_cast<std::size_t>(node.offset), static_cast<std::size_t>(node.count));
+          continue;
+        }
+        // Se apila primero el hijo lejano para visitar antes el cercano
+        if (br.negative[node.axis]) {
+          stack[top++] = idx + 1;
+          stack[top++] = node.offset;
+        } else {
+          stack[top++] = node.offset;
+          stack[top++] = idx + 1;
+        }
+      }
+    }
+
+    static constexpr std::size_t max_depth = 48;
+
+  private:
+    std::vector<bvh_node> nodes;
+    std::vector<std::uint32_t> order;
+  };
+
+}  // namespace render
+
+#endif
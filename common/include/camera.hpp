@@ -0,0 +1,30 @@
+#ifndef RENDER_CAMERA_HPP
+#define RENDER_CAMERA_HPP
+
+#include "parser.hpp"
+#include "ray.hpp"
+#include "vector.hpp"
+
+namespace render {
+
+  // Cámara de proyección perspectiva construida a partir de la configuración
+  class camera {
+  public:
+    camera(Config const & cfg, int width, int height);
+
+    // Rayo primario que atraviesa el píxel (row, col) desplazado (dx, dy) dentro del píxel
+    [[nodiscard]] ray primary_ray(int row, int col, double dx, double dy) const;
+
+  private:
+    vector position;
+    vector origin;  // esquina superior izquierda del plano de proyección
+    vector delta_x;
+    vector delta_y;
+  };
+
+  // Altura de la imagen según ancho y relación de aspecto
+  int image_height(Config const & cfg);
+
+}  // namespace render
+
+#endif
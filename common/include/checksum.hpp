@@ -0,0 +1,15 @@
+#ifndef RENDER_CHECKSUM_HPP
+#define RENDER_CHECKSUM_HPP
+
+#include <cstdint>
+#include <string_view>
+
+namespace render {
+
+  // Suma de comprobación de 64 bits de ficheros binarios propios (escena compilada, punto de
+  // control). No es criptográfica: detecta daños, no manipulaciones.
+  [[nodiscard]] std::uint64_t checksum(std::string_view bytes);
+
+}  // namespace render
+
+#endif
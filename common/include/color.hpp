@@ -0,0 +1,69 @@
+#ifndef RENDER_COLOR_HPP
+#define RENDER_COLOR_HPP
+
+#include "vector.hpp"
+
+#include <array>
+#include <cstdint>
+#include <span>
+#include <vector>
+
+namespace render {
+
+  // Píxel de salida: un byte por canal
+  using rgb8 = std::array<std::uint8_t, 3>;
+
+  // Convierte valor en [0,1] -> 0..255 con corrección gamma
+  int to_u8(double v, double gamma);
+
+  // Convierte un color lineal a RGB de 8 bits con corrección gamma
+  std::array<int, 3> to_rgb8(vector const & c, double gamma);
+
+  // Corrección gamma y cuantización sin std::pow por canal. to_u8 es monótona en v, así que
+  // queda determinada por los 255 umbrales en los que sube de nivel; se calculan una vez por
+  // bisección sobre la propia to_u8 y el resultado coincide exactamente con ella. Con una gamma
+  // no positiva o no finita la curva no es creciente y se usa to_u8 directamente.
+  class tone_mapper {
+  public:
+    explicit tone_mapper(double gamma);
+
+    [[nodiscard]] int to_u8(double v) const {
+      if (not table) {
+        return render::to_u8(v, gamma);
+      }
+      if (not(v > 0.0)) {
+        return 0;
+      }
+      if (v >= 1.0) {
+        return max_level;
+      }
+      // El intervalo da un nivel de partida que nunca supera al buscado
+      auto const bucket = static_cast<std::size_t>(v * static_cast<double>(bucket_count));
+      int level         = bucket_level[bucket];
+      while ((level < max_level) and (v >= thresholds[static_cast<std::size_t>(level) + 1])) {
+        ++level;
+      }
+      return level;
+    }
+
+    [[nodiscard]] std::array<int, 3> to_rgb8(vector const & c) const {
+      return {to_u8(c.get_x()), to_u8(c.get_y()), to_u8(c.get_z())};
+    }
+
+    // Convierte de una pasada un bloque de canales lineales intercalados RGB
+    // (linear.size() == 3 * out.size())
+    void convert(std::span<float const> linear, std::span<rgb8> out) const;
+
+  private:
+    static constexpr int max_level            = 255;
+    static constexpr std::size_t bucket_count = 4'096;
+
+    double gamma;
+    bool table;
+    std::array<double, max_level + 1> thresholds{};  // [k]: menor v con to_u8(v) >= k
+    std::vector<std::uint8_t> bucket_level;          // nivel en el inicio del intervalo anterior
+  };
+
+}  // namespace render
+
+#endif
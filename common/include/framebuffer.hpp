@@ -0,0 +1,59 @@
+#ifndef RENDER_FRAMEBUFFER_HPP
+#define RENDER_FRAMEBUFFER_HPP
+
+#include "color.hpp"
+#include "vector.hpp"
+
+#include <cstddef>
+#include <span>
+#include <vector>
+
+namespace render {
+
+  // Imagen en color lineal durante el render: tres float por píxel, intercalados y por filas.
+  // Los 8 bits por canal solo se calculan al sacar la imagen, franja a franja.
+  class framebuffer {
+  public:
+    framebuffer(int width, int height);
+
+    [[nodiscard]] int get_width() const { return width; }
+
+    [[nodiscard]] int get_height() const { return height; }
+
+    [[nodiscard]] std::size_t index(int row, int col) const {
+      return static_cast<std::size_t>(row) * static_cast<std::size_t>(width) +
+             static_cast<std::size_t>(col);
+    }
+
+    void set(std::size_t pixel, vector const & c) {
+      float * const p = &linear[3 * pixel];
+      p[0]            = static_cast<float>(c.get_x());
+      p[1]            = static_cast<float>(c.get_y());
+      p[2]            = static_cast<float>(c.get_z());
+    }
+
+    [[nodiscard]] vector get(std::size_t pixel) const {
+      float const * const p = &linear[3 * pixel];
+      return {p[0], p[1], p[2]};
+    }
+
+    // Canales de las filas [row0, row0 + count)
+    [[nodiscard]] std::span<float const> rows(int row0, int count) const;
+
+    // Cuantiza las filas [row0, row0 + count) en out (count * width píxeles)
+    void pack_rows(int row0, int count, tone_mapper const & mapper, std::span<rgb8> out) const;
+
+    // Imagen completa en 8 bits
+    [[nodiscard]] std::vector<rgb8> pack(tone_mapper const & mapper) const;
+
+    bool operator==(framebuffer const & other) const = default;
+
+  private:
+    int width;
+    int height;
+    std::vector<float> linear;
+  };
+
+}  // namespace render
+
+#endif
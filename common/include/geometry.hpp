@@ -0,0 +1,123 @@
+#ifndef RENDER_GEOMETRY_HPP
+#define RENDER_GEOMETRY_HPP
+
+#include "ray.hpp"
+#include "vector.hpp"
+
+#include <array>
+#include <cmath>
+
+namespace render {
+
+  // Distancia mínima de intersección para evitar auto-intersecciones (acné)
+  inline constexpr double min_hit_distance = 1e-3;
+
+  // Por debajo de este valor el rayo se considera paralelo al eje o a las tapas de un cilindro
+  inline constexpr double parallel_epsilon = 1e-12;
+
+  // Tolerancia para distinguir un punto de la tapa de un cilindro de uno de la superficie lateral
+  inline constexpr double cap_epsilon = 1e-8;
+
+  // Datos de la intersección más cercana
+  struct hit_record {
+    double t = 0.0;
+    vector point;
+    vector normal;  // normal exterior unitaria
+    int material = -1;
+  };
+
+  // Intersección rayo-esfera. Devuelve el menor t en [t_min, t_max].
+  inline bool hit_sphere(ray const & r, vector const & center, double radius, double t_min,
+                         double t_max, double & t) {
+    vector const oc     = r.origin - center;
+    double const a      = r.direction.dot(r.direction);
+    double const half_b = oc.dot(r.direction);
+    double const c      = oc.dot(oc) - radius * radius;
+    double const disc   = half_b * half_b - a * c;
+    if (disc < 0.0) {
+      return false;
+    }
+    double const sq = std::sqrt(disc);
+    double root     = (-half_b - sq) / a;
+    if (not((root >= t_min) and (root <= t_max))) {
+      root = (-half_b + sq) / a;
+      if (not((root >= t_min) and (root <= t_max))) {
+        return false;
+      }
+    }
+    t = root;
+    return true;
+  }
+
+  // Intersección rayo-cilindro cerrado (superficie lateral y dos tapas).
+  // El cilindro está centrado en center, con eje unitario axis y semialtura half_height.
+  inline bool hit_cylinder(ray const & r, vector const & center, double radius,
+                           vector const & axis, double half_height, double t_min, double t_max,
+                           double & t) {
+    vector const oc   = r.origin - center;
+    double const d_a  = r.direction.dot(axis);
+    double const oc_a = oc.dot(axis);
+    vector const d_p  = r.direction - axis * d_a;
+    vector const oc_p = oc - axis * oc_a;
+    double const r2   = radius * radius;
+    double best       = t_max;
+    bool found        = false;
+
+    // Superficie lateral: componentes perpendiculares al eje
+    double const a = d_p.dot(d_p);
+    if (a > parallel_epsilon) {
+      double const half_b = oc_p.dot(d_p);
+      double const c      = oc_p.dot(oc_p) - r2;
+      double const disc   = half_b * half_b - a * c;
+      if (disc >= 0.0) {
+        double const sq                 = std::sqrt(disc);
+        std::array<double, 2> const rts = {(-half_b - sq) / a, (-half_b + sq) / a};
+        for (double const root : rts) {
+          if ((root >= t_min) and (root <= best) and
+              (std::abs(oc_a + root * d_a) <= half_height)) {
+            best  = root;
+            found = true;
+            break;
+          }
+        }
+      }
+    }
+
+    // Tapas: planos perpendiculares al eje a +-half_height del centro
+    if (std::abs(d_a) > parallel_epsilon) {
+      std::array<double, 2> const sides = {-half_height, half_height};
+      for (double const side : sides) {
+        double const root = (side - oc_a) / d_a;
+        if ((root >= t_min) and (root <= best)) {
+          vector const q = oc_p + d_p * root;
+          if (q.dot(q) <= r2) {
+            best  = root;
+            found = true;
+          }
+        }
+      }
+    }
+
+    if (found) {
+      t = best;
+    }
+    return found;
+  }
+
+  inline vector sphere_normal(vector const & point, vector const & center, double radius) {
+    return (point - center) / radius;
+  }
+
+  inline vector cylinder_normal(vector const & point, vector const & center, double radius,
+                                vector const & axis, double half_height) {
+    vector const rel = point - center;
+    double const h   = rel.dot(axis);
+    if (std::abs(h) >= half_height - cap_epsilon) {
+      return (h > 0.0) ? axis : -axis;
+    }
+    return (rel - axis * h) / radius;
+  }
+
+}  // namespace render
+
+#endif
@@ -0,0 +1,32 @@
+#ifndef RENDER_MAPPED_FILE_HPP
+#define RENDER_MAPPED_FILE_HPP
+
+#include <cstddef>
+#include <string>
+#include <string_view>
+
+namespace render {
+
+  // Fichero de solo lectura proyectado en memoria con mmap. Los ficheros vacíos o que no se
+  // pueden proyectar (tuberías, dispositivos) se leen a un búfer propio.
+  class mapped_file {
+  public:
+    // Lanza std::runtime_error si el fichero no se puede abrir
+    explicit mapped_file(std::string const & path);
+    ~mapped_file();
+
+    mapped_file(mapped_file const &)             = delete;
+    mapped_file & operator=(mapped_file const &) = delete;
+
+    [[nodiscard]] std::string_view view() const { return contents; }
+
+  private:
+    void * mapping          = nullptr;
+    std::size_t mapped_size = 0;
+    std::string buffer;
+    std::string_view contents;
+  };
+
+}  // namespace render
+
+#endif
@@ -0,0 +1,42 @@
+#ifndef RENDER_OPTIONS_HPP
+#define RENDER_OPTIONS_HPP
+
+#include <span>
+#include <string>
+#include <vector>
+
+namespace render {
+
+  // Opciones de línea de órdenes: argumentos posicionales y opciones --clave=valor
+  struct options {
+    std::vector<std::string> positional;
+    std::string simd   = "auto";  // núcleos SIMD de render-soa: auto, scalar, avx2, avx512
+    std::string accel  = "bvh";   // estructura de aceleración: bvh o none (fuerza bruta)
+    std::string format = "p3";    // formato de salida: p3 (texto) o p6 (binario)
+    int threads        = -1;      // hilos de render; -1 = lo que indique la configuración
+    std::string compile_scene;    // si no está vacío, escena compilada a escribir (sin render)
+    std::string stats;            // si no está vacío, fichero JSON con tiempos y contadores
+    std::string checkpoint;       // si no está vacío, render progresivo con este punto de control
+    int pass_samples        = 4;   // muestras por píxel de cada pasada del render progresivo
+    int checkpoint_interval = 60;  // segundos mínimos entre puntos de control
+
+    // Recorrido de los caminos en render-soa: recursive (cada muestra entera) o wavefront
+    std::string integrator = "recursive";
+    // Precisión de los núcleos de intersección de render-soa: double o float
+    std::string precision = "double";
+
+    // Modo por lotes: la salida es un patrón con '#' para el número de fotograma
+    std::string frames;  // si no está vacío, fichero de fotogramas (ver animation.hpp)
+    int turntable = 0;   // si no es 0, fotogramas de una vuelta de cámara alrededor del objetivo
+
+    // Modo servidor (ver render_server.hpp): sin argumentos posicionales
+    std::string serve;    // si no está vacío, socket Unix en el que se atienden trabajos
+    int scene_cache = 4;  // escenas preparadas que se conservan entre trabajos
+  };
+
+  // Lanza std::runtime_error ante opciones desconocidas, sin valor o con valor no válido
+  options parse_options(std::span<char *> args);
+
+}  // namespace render
+
+#endif
@@ -1,6 +1,9 @@
 #pragma once
+#include "thread_pool.hpp"
 #include <array>
+#include <cstdint>
 #include <string>
+#include <string_view>
 #include <utility>
 #include <vector>
 
@@ -11,18 +14,18 @@ enum class MaterialType { Matte, Metal, Refractive };
 struct Material {
   std::string name;
   MaterialType type;
-  std::vector<double> params;  // reflectancia (3), difusión (1) o índice de refracción (1)
+  std::array<double, 4> params;  // reflectancia (3) y difusión, o índice de refracción en [0]
 };
 
 // Tipos de objetos
 enum class ObjectType { Sphere, Cylinder };
 
-// Objeto
+// Objeto de tamaño fijo: sin memoria dinámica por objeto
 struct Object {
   ObjectType type;
-  std::vector<double> params;  // para sphere: cx,cy,cz,r   para cylinder: cx,cy,cz,r,ax,ay,az
-  std::string material;
-  std::string raw_line;  // guarda la línea original (útil para errores/debug)
+  std::uint32_t material_index;  // posición del material en el vector de materiales
+  std::array<double, 7> params;  // para sphere: cx,cy,cz,r   para cylinder: cx,cy,cz,r,ax,ay,az
+  std::uint64_t line_offset;     // inicio de la línea original en el fichero (readObjectLine)
 };
 
 // Configuración global
@@ -40,9 +43,24 @@ struct Config {
   int ray_rng_seed                             = 19;
   std::array<double, 3> background_dark_color  = {0.25, 0.5, 1.0};
   std::array<double, 3> background_light_color = {1.0, 1.0, 1.0};
+  int threads                                  = 0;  // hilos de render (0 = todos los núcleos)
+  // Muestreo adaptativo: un píxel deja de muestrearse cuando el error típico de su media, tras
+  // la corrección gamma, baja de adaptive_threshold (0 = siempre samples_per_pixel). Se
+  // comprueba cada adaptive_round muestras.
+  double adaptive_threshold = 0.0;
+  int adaptive_round        = 8;
 };
 
 // Funciones de parsing
 // Lanzan std::runtime_error con mensajes EXACTOS (según enunciado) cuando hay errores.
 Config parseConfig(std::string const & filename);
+// Aplica a cfg una línea con el formato del fichero de configuración (las vacías no cambian nada)
+void parseConfigLine(std::string_view line, Config & cfg);
 std::pair<std::vector<Material>, std::vector<Object>> parseScene(std::string const & filename);
+// Igual que la anterior, pero reparte los ficheros grandes en trozos que se analizan en paralelo
+// con los hilos de pool. Los errores son los mismos que en la lectura secuencial.
+std::pair<std::vector<Material>, std::vector<Object>>
+    parseScene(std::string const & filename, render::work_stealing_pool & pool);
+
+// Devuelve la línea original de un objeto leyéndola del fichero de escena del que procede
+std::string readObjectLine(std::string const & filename, Object const & obj);
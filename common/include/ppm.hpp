@@ -0,0 +1,42 @@
+#ifndef RENDER_PPM_HPP
+#define RENDER_PPM_HPP
+
+#include "color.hpp"
+
+#include <cstddef>
+#include <ostream>
+#include <span>
+#include <string>
+
+namespace render {
+
+  // Variante de PPM: P3 (texto, la del enunciado) o P6 (binaria)
+  enum class ppm_format { p3, p6 };
+
+  // Lanza std::runtime_error si el nombre no corresponde a ningún formato
+  ppm_format parse_ppm_format(std::string const & name);
+
+  // Escritor de PPM por filas. La cabecera sigue el enunciado en ambos formatos: número de
+  // líneas (height) seguido de número de columnas (width). Los píxeles se formatean en un búfer
+  // propio que se vuelca al flujo en bloques grandes.
+  class ppm_writer {
+  public:
+    ppm_writer(std::ostream & out, int width, int height, ppm_format format);
+
+    // Añade píxeles consecutivos (filas completas, en orden)
+    void write(std::span<rgb8 const> pixels);
+
+    // Vuelca el búfer; lanza std::runtime_error si el flujo ha fallado
+    void finish();
+
+  private:
+    void flush();
+
+    std::ostream & out;
+    ppm_format format;
+    std::string buffer;
+  };
+
+}  // namespace render
+
+#endif
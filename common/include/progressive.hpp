@@ -0,0 +1,73 @@
+#ifndef RENDER_PROGRESSIVE_HPP
+#define RENDER_PROGRESSIVE_HPP
+
+#include "framebuffer.hpp"
+#include "parser.hpp"
+#include "ppm.hpp"
+#include "sampling.hpp"
+
+#include <cstdint>
+#include <functional>
+#include <optional>
+#include <ostream>
+#include <span>
+#include <string>
+#include <vector>
+
+namespace render {
+
+  // Estado de un render progresivo: estimación acumulada de cada píxel y pasadas terminadas.
+  // Cada pasada usa sus propios flujos de números, así que el estado de los generadores queda
+  // determinado por passes_done y no hace falta guardarlo aparte.
+  struct progress_state {
+    int width;
+    int height;
+    int pass_samples;          // muestras por píxel de cada pasada
+    std::uint64_t fingerprint;  // de los ficheros de entrada
+    int passes_done = 0;
+    std::vector<pixel_estimate> pixels;
+
+    progress_state(int width, int height, int pass_samples, std::uint64_t fingerprint);
+
+    // Pasadas necesarias para llegar a samples_per_pixel
+    [[nodiscard]] int pass_count(Config const & cfg) const;
+
+    // Media de cada píxel; negro si aún no tiene muestras
+    [[nodiscard]] framebuffer image() const;
+  };
+
+  // Versión del formato de los puntos de control. La 2 corresponde a los flujos de números por
+  // muestra: un punto de control anterior se reanudaría con muestras de otros flujos.
+  inline constexpr std::uint32_t checkpoint_version = 2;
+
+  // Huella del contenido de los ficheros de entrada: un punto de control solo se reanuda con
+  // la misma configuración y la misma escena
+  [[nodiscard]] std::uint64_t input_fingerprint(std::span<std::string const> paths);
+
+  // Escribe el punto de control en un fichero temporal y lo renombra: un proceso interrumpido
+  // a mitad de escritura deja intacto el anterior. Lanza std::runtime_error si no puede.
+  void write_checkpoint(std::string const & path, progress_state const & state);
+
+  // Lee el punto de control de path si existe. Lanza std::runtime_error si está dañado o si
+  // no corresponde al mismo render que expected (tamaño, pasadas o ficheros de entrada).
+  [[nodiscard]] std::optional<progress_state> read_checkpoint(std::string const & path,
+                                                              progress_state const & expected);
+
+  // Parámetros del modo progresivo
+  struct progressive_job {
+    std::string checkpoint;  // fichero de punto de control
+    std::string output;      // imagen, reescrita con cada punto de control
+    ppm_format format;
+    int interval;  // segundos mínimos entre puntos de control (0 = tras cada pasada)
+  };
+
+  // Renderiza por pasadas de state.pass_samples muestras hasta samples_per_pixel. Reanuda desde
+  // el punto de control si existe y, cada job.interval segundos y al terminar, guarda el punto
+  // de control y una vista previa de la imagen. render_pass(state) hace una pasada.
+  void run_progressive(Config const & cfg, progressive_job const & job, progress_state & state,
+                       std::function<void(progress_state &)> const & render_pass,
+                       std::ostream & log);
+
+}  // namespace render
+
+#endif
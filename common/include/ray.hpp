@@ -0,0 +1,18 @@
+#ifndef RENDER_RAY_HPP
+#define RENDER_RAY_HPP
+
+#include "vector.hpp"
+
+namespace render {
+
+  // Rayo con origen y dirección unitaria
+  struct ray {
+    vector origin;
+    vector direction;
+
+    [[nodiscard]] vector at(double t) const { return origin + direction * t; }
+  };
+
+}  // namespace render
+
+#endif
@@ -0,0 +1,113 @@
+#ifndef RENDER_RENDER_SERVER_HPP
+#define RENDER_RENDER_SERVER_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <list>
+#include <memory>
+#include <ostream>
+#include <string>
+#include <string_view>
+
+namespace render {
+
+  // Modo servidor: el renderizador se queda en marcha escuchando en un socket Unix y cada
+  // conexión es un trabajo. El cliente envía una línea "<config> <escena>\n" y recibe la imagen
+  // PPM a medida que se renderiza, o una línea con el mensaje de error si el trabajo falla
+  // antes de empezar. La línea "quit\n" detiene el servidor. El binario, el pool de hilos y las
+  // escenas usadas recientemente (ya analizadas y con su BVH) se conservan entre trabajos; una
+  // escena cuyo fichero ha cambiado se recarga a partir de la versión anterior
+  // (scene_reload.hpp).
+
+  struct render_request {
+    std::string config_path;
+    std::string scene_path;
+  };
+
+  // Lanza std::runtime_error si la línea no tiene exactamente dos rutas
+  [[nodiscard]] render_request parse_request(std::string_view line);
+
+  // Clave de caché de una escena: suma de comprobación y tamaño del contenido del fichero, de
+  // modo que dos rutas con el mismo contenido comparten escena y un fichero modificado no
+  // reutiliza la anterior. Lanza std::runtime_error si el fichero no se puede leer.
+  struct scene_key {
+    std::uint64_t hash = 0;
+    std::size_t size   = 0;
+
+    bool operator==(scene_key const &) const = default;
+  };
+
+  [[nodiscard]] scene_key scene_file_key(std::string const & path);
+
+  // Caché LRU de escenas preparadas para render. Las escenas se comparten con shared_ptr: una
+  // expulsada sigue viva mientras la use un trabajo.
+  template <typename Scene>
+  class scene_lru {
+  public:
+    explicit scene_lru(std::size_t max_scenes) : capacity{max_scenes} {}
+
+    // Escena del fichero path. Si no hay ninguna con el mismo contenido se obtiene con
+    // load(previous), donde previous es la versión anterior del mismo fichero que siga en la
+    // caché (nullptr si no hay), y la nueva la sustituye.
+    template <typename Load>
+    std::shared_ptr<Scene const> get(std::string const & path, Load && load) {
+      scene_key const key = scene_file_key(path);
+      auto previous       = entries.end();
+      for (auto it = entries.begin(); it != entries.end(); ++it) {
+        if (it->key == key) {
+          entries.splice(entries.begin(), entries, it);
+          ++hit_count;
+          return entries.front().scene;
+        }
+        if ((previous == entries.end()) and (it->path == path)) {
+          previous = it;
+        }
+      }
+      ++miss_count;
+      auto scn = std::make_shared<Scene const>(
+          load((previous != entries.end()) ? previous->scene.get() : nullptr));
+      if (previous != entries.end()) {
+        entries.erase(previous);
+      }
+      if (capacity > 0) {
+        if (entries.size() == capacity) {
+          entries.pop_back();
+        }
+        entries.push_front({key, path, scn});
+      }
+      return scn;
+    }
+
+    [[nodiscard]] std::size_t size() const { return entries.size(); }
+
+    [[nodiscard]] std::uint64_t hits() const { return hit_count; }
+
+    [[nodiscard]] std::uint64_t misses() const { return miss_count; }
+
+  private:
+    struct entry {
+      scene_key key;
+      std::string path;  // fichero del que se cargó
+      std::shared_ptr<Scene const> scene;
+    };
+
+    std::size_t capacity;
+    std::list<entry> entries;  // las usadas más recientemente, antes
+    std::uint64_t hit_count  = 0;
+    std::uint64_t miss_count = 0;
+  };
+
+  // Trabajo de un cliente: escribe la imagen en out. Si lanza antes de escribir nada, el
+  // mensaje de la excepción se envía al cliente como respuesta.
+  using render_handler = std::function<void(render_request const &, std::ostream & out)>;
+
+  // Escucha en socket_path (que se crea y se borra al terminar) y atiende las conexiones de una
+  // en una: cada trabajo ya usa todos los hilos del pool. Las peticiones que llegan mientras
+  // tanto esperan en la cola del socket. Escribe una línea por trabajo en log. Lanza
+  // std::runtime_error si no se puede crear el socket.
+  void serve(std::string const & socket_path, render_handler const & handler, std::ostream & log);
+
+}  // namespace render
+
+#endif
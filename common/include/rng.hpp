@@ -0,0 +1,83 @@
+#ifndef RENDER_RNG_HPP
+#define RENDER_RNG_HPP
+
+#include <array>
+#include <cstdint>
+#include <limits>
+
+namespace render {
+
+  // Bloque de Philox4x32-10 (Salmon et al., SC'11): cifra el contador ctr con la clave key.
+  // Diez rondas de dos productos de 32x32 bits; pasa BigCrush con cualquier contador.
+  [[nodiscard]] constexpr std::array<std::uint32_t, 4>
+      philox4x32(std::array<std::uint32_t, 4> ctr, std::array<std::uint32_t, 2> key) {
+    constexpr std::uint64_t m0 = 0xD251'1F53U;
+    constexpr std::uint64_t m1 = 0xCD9E'8D57U;
+    constexpr std::uint32_t w0 = 0x9E37'79B9U;
+    constexpr std::uint32_t w1 = 0xBB67'AE85U;
+    for (int round = 0; round < 10; ++round) {
+      std::uint64_t const p0 = m0 * ctr[0];
+      std::uint64_t const p1 = m1 * ctr[2];
+      auto const hi0         = static_cast<std::uint32_t>(p0 >> 32U);
+      auto const hi1         = static_cast<std::uint32_t>(p1 >> 32U);
+      ctr = {hi1 ^ ctr[1] ^ key[0], static_cast<std::uint32_t>(p1), hi0 ^ ctr[3] ^ key[1],
+             static_cast<std::uint32_t>(p0)};
+      key[0] += w0;
+      key[1] += w1;
+    }
+    return ctr;
+  }
+
+  // Muestra de la imagen: píxel (índice en la imagen) y número de muestra dentro del píxel
+  struct sample_id {
+    std::uint64_t pixel;
+    std::uint32_t sample;
+  };
+
+  // Generador basado en contador. El número i del flujo (key, muestra, rebote) es la mitad
+  // i % 2 del bloque Philox del contador {píxel, muestra, rebote << 16 | i / 2}: no hay estado
+  // compartido ni orden de consumo, así que cualquier muestra de cualquier rebote se genera
+  // igual en cualquier hilo o carril SIMD. Cumple UniformRandomBitGenerator.
+  class rng_engine {
+  public:
+    using result_type = std::uint64_t;
+
+    rng_engine(std::uint64_t key, sample_id id, std::uint32_t bounce)
+        : key{static_cast<std::uint32_t>(key), static_cast<std::uint32_t>(key >> 32U)},
+          ctr{static_cast<std::uint32_t>(id.pixel), static_cast<std::uint32_t>(id.pixel >> 32U),
+              id.sample, bounce << 16U} {}
+
+    static constexpr result_type min() { return 0; }
+
+    static constexpr result_type max() { return std::numeric_limits<result_type>::max(); }
+
+    result_type operator()() {
+      if (not has_spare) {
+        block = philox4x32(ctr, key);
+        ++ctr[3];
+        has_spare = true;
+        return (std::uint64_t{block[0]} << 32U) | block[1];
+      }
+      has_spare = false;
+      return (std::uint64_t{block[2]} << 32U) | block[3];
+    }
+
+    // Número uniforme en [lo, hi) con los 53 bits altos del siguiente valor. Evita
+    // std::uniform_real_distribution, cuya conversión cuesta más que el propio bloque Philox.
+    double uniform(double lo, double hi) {
+      return lo + (hi - lo) * (static_cast<double>((*this)() >> 11U) * 0x1.0p-53);
+    }
+
+  private:
+    std::array<std::uint32_t, 2> key;
+    std::array<std::uint32_t, 4> ctr;
+    std::array<std::uint32_t, 4> block{};
+    bool has_spare = false;
+  };
+
+  // Clave de los generadores derivada de una semilla de configuración (mezcla splitmix64)
+  [[nodiscard]] std::uint64_t rng_key(int seed);
+
+}  // namespace render
+
+#endif
@@ -0,0 +1,114 @@
+#ifndef RENDER_SAMPLING_HPP
+#define RENDER_SAMPLING_HPP
+
+#include "parser.hpp"
+#include "vector.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <type_traits>
+
+namespace render {
+
+  // Suma de las muestras de un píxel y de sus cuadrados, por canal. La media es exactamente
+  // sum / n, como con un número fijo de muestras.
+  class pixel_estimate {
+  public:
+    void add(vector const & sample) {
+      sum += sample;
+      sum_sq += sample.hadamard(sample);
+      ++count;
+    }
+
+    // Une las muestras de otra estimación del mismo píxel
+    void merge(pixel_estimate const & other) {
+      sum += other.sum;
+      sum_sq += other.sum_sq;
+      count += other.count;
+    }
+
+    [[nodiscard]] int get_count() const { return count; }
+
+    [[nodiscard]] vector mean() const { return sum / static_cast<double>(count); }
+
+    // Error típico de la media tras la corrección gamma, en el canal peor: el de cada canal,
+    // sqrt(s² / n), por la pendiente de v^(1/gamma) en la media. Así los tonos oscuros, donde
+    // la corrección amplía las diferencias, piden más muestras que los claros.
+    [[nodiscard]] double display_error(double gamma) const {
+      if (count < 2) {
+        return std::numeric_limits<double>::infinity();
+      }
+      double const n = static_cast<double>(count);
+      auto channel   = [n, gamma](double s, double sq) {
+        double const variance = std::max(0.0, (sq - s * s / n) / (n - 1.0));
+        double const level    = std::max(s / n, min_level);
+        return std::sqrt(variance / n) * std::pow(level, 1.0 / gamma - 1.0) / gamma;
+      };
+      return std::max({channel(sum.get_x(), sum_sq.get_x()), channel(sum.get_y(), sum_sq.get_y()),
+                       channel(sum.get_z(), sum_sq.get_z())});
+    }
+
+  private:
+    static constexpr double min_level = 1.0 / 255.0;  // por debajo, la pendiente no se acota
+
+    vector sum;
+    vector sum_sq;
+    int count = 0;
+  };
+
+  // Se guarda tal cual en los puntos de control del render progresivo
+  static_assert(std::is_trivially_copyable_v<pixel_estimate>);
+
+  // Muestras que toma un píxel en un render o en una pasada: las de índice [first, first + count)
+  struct sample_range {
+    int first;
+    int count;
+  };
+
+  // Muestreo de un píxel: rondas de adaptive_round muestras hasta que el error típico de la
+  // media, visto tras la corrección gamma, baja de adaptive_threshold o se llega a
+  // samples_per_pixel. Sin umbral no hay rondas.
+  class sample_policy {
+  public:
+    explicit sample_policy(Config const & cfg)
+        : max_samples{cfg.samples_per_pixel}, round{cfg.adaptive_round},
+          threshold{cfg.adaptive_threshold}, gamma{cfg.gamma} {}
+
+    // Siempre max_samples muestras, sin rondas
+    explicit sample_policy(int max_samples)
+        : max_samples{max_samples}, round{1}, threshold{0.0}, gamma{1.0} {}
+
+    [[nodiscard]] int get_max_samples() const { return max_samples; }
+
+    // Indica si la estimación ya cumple el umbral (nunca sin muestreo adaptativo)
+    [[nodiscard]] bool converged(pixel_estimate const & est) const {
+      return (threshold > 0.0) and (est.display_error(gamma) <= threshold);
+    }
+
+    // Muestras que se pueden tomar seguidas tras las taken ya tomadas sin que done cambie
+    // entre medias: hasta el final de la ronda o, sin umbral, hasta el máximo
+    [[nodiscard]] int batch_size(int taken) const {
+      int const left = max_samples - taken;
+      return (threshold > 0.0) ? std::min(left, round - taken % round) : left;
+    }
+
+    // Se consulta tras cada muestra
+    [[nodiscard]] bool done(pixel_estimate const & est) const {
+      int const n = est.get_count();
+      if (n >= max_samples) {
+        return true;
+      }
+      return (n % round == 0) and converged(est);
+    }
+
+  private:
+    int max_samples;
+    int round;
+    double threshold;
+    double gamma;
+  };
+
+}  // namespace render
+
+#endif
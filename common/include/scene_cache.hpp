@@ -0,0 +1,59 @@
+#ifndef RENDER_SCENE_CACHE_HPP
+#define RENDER_SCENE_CACHE_HPP
+
+#include "bvh.hpp"
+#include "parser.hpp"
+
+#include <cstdint>
+#include <optional>
+#include <span>
+#include <string>
+#include <vector>
+
+namespace render {
+
+  // Jerarquías que puede guardar una escena compilada: la de render-aos (todos los objetos) o
+  // las dos de render-soa (una por tipo de primitivo)
+  enum class cached_bvh : std::uint32_t { aos, soa_spheres, soa_cylinders };
+
+  struct cache_hierarchy {
+    cached_bvh kind;
+    bvh const * hierarchy;
+  };
+
+  // Versión del formato. Hay que incrementarla si cambia la disposición del fichero o la forma
+  // de construir las jerarquías (tamaño de hoja, cálculo de cajas), porque se cargan tal cual.
+  inline constexpr std::uint32_t scene_cache_version = 1;
+
+  // Escribe la escena compilada: cabecera con versión y suma de comprobación, directorio de
+  // secciones y, alineadas a 64 bytes, la tabla de materiales, una columna por atributo de los
+  // objetos y las jerarquías no vacías. Lanza std::runtime_error si no se puede escribir.
+  void write_scene_cache(std::string const & path, std::vector<Material> const & materials,
+                         std::vector<Object> const & objects,
+                         std::span<cache_hierarchy const> hierarchies = {});
+
+  // Indica si el fichero empieza por la firma de una escena compilada
+  [[nodiscard]] bool is_scene_cache(std::string const & path);
+
+  // Escena compilada leída de un fichero proyectado en memoria, sin análisis de texto.
+  // Lanza std::runtime_error si la versión no coincide o el contenido está dañado.
+  class scene_cache {
+  public:
+    explicit scene_cache(std::string const & path);
+
+    [[nodiscard]] std::vector<Material> const & get_materials() const { return materials; }
+
+    [[nodiscard]] std::vector<Object> const & get_objects() const { return objects; }
+
+    // Jerarquía precalculada, o nullptr si la escena se compiló sin ella
+    [[nodiscard]] bvh const * find_hierarchy(cached_bvh kind) const;
+
+  private:
+    std::vector<Material> materials;
+    std::vector<Object> objects;
+    std::vector<std::optional<bvh>> hierarchies;
+  };
+
+}  // namespace render
+
+#endif
@@ -0,0 +1,66 @@
+#ifndef RENDER_SCENE_RELOAD_HPP
+#define RENDER_SCENE_RELOAD_HPP
+
+#include "parser.hpp"
+
+#include <cstddef>
+#include <cstdint>
+#include <utility>
+#include <vector>
+
+namespace render {
+
+  // Diferencias entre dos análisis de una escena. Los objetos se comparan por posición en el
+  // fichero y por contenido (tipo, material y parámetros), no por la línea de texto: editar
+  // una línea desplaza las de detrás, pero no las cambia. Los materiales se comparan por valor;
+  // los objetos ya los referencian por índice, así que renombrar uno no cambia nada.
+  struct scene_diff {
+    // Cambia el número de materiales u objetos, o el tipo de algún objeto: no se puede
+    // actualizar la escena anterior
+    bool structural = false;
+    std::vector<std::uint32_t> materials;  // índices de los materiales modificados
+    std::vector<std::uint32_t> objects;    // índices de los objetos modificados
+
+    // Cierto si compensa actualizar la escena anterior y reajustar las cajas del BVH en lugar
+    // de construirla de nuevo. Con muchos objetos modificados la jerarquía reajustada pierde
+    // calidad y se prefiere reconstruir.
+    [[nodiscard]] bool refittable(std::size_t object_count) const;
+  };
+
+  [[nodiscard]] scene_diff diff_scenes(std::vector<Material> const & old_materials,
+                                       std::vector<Object> const & old_objects,
+                                       std::vector<Material> const & new_materials,
+                                       std::vector<Object> const & new_objects);
+
+  // Escena de render junto con el análisis del que procede, para poder recargarla.
+  // Scene es render::aos::scene o render::soa::scene.
+  template <typename Scene>
+  struct reloadable_scene {
+    std::vector<Material> materials;
+    std::vector<Object> objects;
+    Scene scene;
+  };
+
+  // Escena del análisis (materials, objects). Si la versión anterior existe y los cambios son
+  // pocos, se copia y se actualiza con Scene::update; si no, se construye con build(materials,
+  // objects).
+  template <typename Scene, typename Build>
+  reloadable_scene<Scene> reload_scene(reloadable_scene<Scene> const * previous,
+                                       std::vector<Material> materials,
+                                       std::vector<Object> objects, Build && build) {
+    if (previous != nullptr) {
+      scene_diff const diff =
+          diff_scenes(previous->materials, previous->objects, materials, objects);
+      if (diff.refittable(objects.size())) {
+        Scene scn = previous->scene;
+        scn.update(materials, objects, diff);
+        return {std::move(materials), std::move(objects), std::move(scn)};
+      }
+    }
+    Scene scn = build(materials, objects);
+    return {std::move(materials), std::move(objects), std::move(scn)};
+  }
+
+}  // namespace render
+
+#endif
@@ -0,0 +1,121 @@
+#ifndef RENDER_SHADING_HPP
+#define RENDER_SHADING_HPP
+
+#include "geometry.hpp"
+#include "parser.hpp"
+#include "ray.hpp"
+#include "rng.hpp"
+#include "vector.hpp"
+
+#include <algorithm>
+#include <cmath>
+
+namespace render {
+
+  // Parámetros de sombreado de un material, independientes de la disposición en memoria
+  struct surface {
+    MaterialType type;
+    vector reflectance;  // mate y metal
+    double param;        // difusión (metal) o índice de refracción (refractivo)
+  };
+
+  surface make_surface(Material const & mat);
+
+  // Resultado de la dispersión de un rayo en una superficie
+  struct scatter_result {
+    ray scattered;
+    vector attenuation;
+  };
+
+  namespace detail {
+
+    // Vector con componentes uniformes en [-k, k); la lista con llaves fija el orden
+    inline vector random_vector(rng_engine & gen, double k) {
+      return {gen.uniform(-k, k), gen.uniform(-k, k), gen.uniform(-k, k)};
+    }
+
+    inline vector reflect(vector const & d, vector const & n) {
+      return d - n * (2.0 * d.dot(n));
+    }
+
+  }  // namespace detail
+
+  // Dispersión de cada tipo de material por separado, para sombrear colas de un solo tipo
+  inline bool scatter_matte(surface const & mat, hit_record const & hit, rng_engine & gen,
+                            scatter_result & out) {
+    vector dir = hit.normal + detail::random_vector(gen, 1.0);
+    if (dir.near_zero()) {
+      dir = hit.normal;
+    }
+    out.scattered   = {hit.point, dir.normalized()};
+    out.attenuation = mat.reflectance;
+    return true;
+  }
+
+  inline bool scatter_metal(surface const & mat, ray const & r_in, hit_record const & hit,
+                            rng_engine & gen, scatter_result & out) {
+    vector const reflected = detail::reflect(r_in.direction, hit.normal).normalized();
+    vector const dir       = reflected + detail::random_vector(gen, mat.param);
+    if (dir.dot(hit.normal) <= 0.0) {
+      return false;
+    }
+    out.scattered   = {hit.point, dir.normalized()};
+    out.attenuation = mat.reflectance;
+    return true;
+  }
+
+  inline bool scatter_refractive(surface const & mat, ray const & r_in, hit_record const & hit,
+                                 scatter_result & out) {
+    bool const front_face = r_in.direction.dot(hit.normal) < 0.0;
+    vector const n        = front_face ? hit.normal : -hit.normal;
+    double const ratio    = front_face ? (1.0 / mat.param) : mat.param;
+    vector const d        = r_in.direction.normalized();
+    double const cos_t    = std::min(-d.dot(n), 1.0);
+    double const sin_t    = std::sqrt(1.0 - cos_t * cos_t);
+
+    vector dir;
+    if (ratio * sin_t > 1.0) {
+      dir = detail::reflect(d, n);
+    } else {
+      vector const r_perp = (d + n * cos_t) * ratio;
+      vector const r_par  = n * -std::sqrt(std::abs(1.0 - r_perp.squared_magnitude()));
+      dir                 = r_perp + r_par;
+    }
+    out.scattered   = {hit.point, dir.normalized()};
+    out.attenuation = {1.0, 1.0, 1.0};
+    return true;
+  }
+
+  // Dispersión con el tipo de material fijado en compilación: un núcleo por tipo, sin switch
+  template <MaterialType Type>
+  bool scatter_as(surface const & mat, ray const & r_in, hit_record const & hit, rng_engine & gen,
+                  scatter_result & out) {
+    if constexpr (Type == MaterialType::Matte) {
+      return scatter_matte(mat, hit, gen, out);
+    } else if constexpr (Type == MaterialType::Metal) {
+      return scatter_metal(mat, r_in, hit, gen, out);
+    } else {
+      return scatter_refractive(mat, r_in, hit, out);
+    }
+  }
+
+  // Calcula el rayo dispersado según el material. Devuelve false si el rayo se absorbe.
+  inline bool scatter(surface const & mat, ray const & r_in, hit_record const & hit,
+                      rng_engine & gen, scatter_result & out) {
+    switch (mat.type) {
+      case MaterialType::Matte:
+        return scatter_as<MaterialType::Matte>(mat, r_in, hit, gen, out);
+      case MaterialType::Metal:
+        return scatter_as<MaterialType::Metal>(mat, r_in, hit, gen, out);
+      case MaterialType::Refractive:
+        return scatter_as<MaterialType::Refractive>(mat, r_in, hit, gen, out);
+    }
+    return false;
+  }
+
+  // Color de fondo para un rayo que no interseca ningún objeto
+  vector background(Config const & cfg, ray const & r);
+
+}  // namespace render
+
+#endif
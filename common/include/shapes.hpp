@@ -0,0 +1,70 @@
+#ifndef RENDER_SHAPES_HPP
+#define RENDER_SHAPES_HPP
+
+#include "bvh.hpp"
+#include "geometry.hpp"
+#include "parser.hpp"
+#include "ray.hpp"
+#include "vector.hpp"
+
+namespace render {
+
+  // Primitivas con el tipo fijado en compilación. Cada escena guarda un contenedor por tipo y
+  // lo recorre con un bucle instanciado para él: sin comprobar el tipo en cada primitivo y con
+  // la intersección en línea.
+  struct sphere_shape {
+    static constexpr ObjectType type = ObjectType::Sphere;
+
+    vector center;
+    double radius;
+    int material;
+
+    [[nodiscard]] bool hit(ray const & r, double t_min, double t_max, double & t) const {
+      return hit_sphere(r, center, radius, t_min, t_max, t);
+    }
+
+    [[nodiscard]] vector normal_at(vector const & point) const {
+      return sphere_normal(point, center, radius);
+    }
+
+    [[nodiscard]] aabb bounds() const { return sphere_bounds(center, radius); }
+  };
+
+  struct cylinder_shape {
+    static constexpr ObjectType type = ObjectType::Cylinder;
+
+    vector center;
+    double radius;
+    vector axis;  // unitario
+    double half_height;
+    int material;
+
+    [[nodiscard]] bool hit(ray const & r, double t_min, double t_max, double & t) const {
+      return hit_cylinder(r, center, radius, axis, half_height, t_min, t_max, t);
+    }
+
+    [[nodiscard]] vector normal_at(vector const & point) const {
+      return cylinder_normal(point, center, radius, axis, half_height);
+    }
+
+    [[nodiscard]] aabb bounds() const {
+      return cylinder_bounds(center, radius, axis, half_height);
+    }
+  };
+
+  // Primitiva del tipo Shape a partir de un objeto leído de la escena (obj.type == Shape::type)
+  template <typename Shape>
+  [[nodiscard]] Shape make_shape(Object const & obj, int material) {
+    vector const center{obj.params[0], obj.params[1], obj.params[2]};
+    if constexpr (Shape::type == ObjectType::Sphere) {
+      return {center, obj.params[3], material};
+    } else {
+      vector const axis{obj.params[4], obj.params[5], obj.params[6]};
+      double const height = axis.magnitude();
+      return {center, obj.params[3], axis / height, height / 2.0, material};
+    }
+  }
+
+}  // namespace render
+
+#endif
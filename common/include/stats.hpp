@@ -0,0 +1,108 @@
+#ifndef RENDER_STATS_HPP
+#define RENDER_STATS_HPP
+
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <mutex>
+#include <ostream>
+#include <string>
+#include <vector>
+
+namespace render {
+
+  // Sonda vacía: el bucle de render instanciado con ella no cuenta nada y las llamadas
+  // desaparecen al optimizar
+  struct no_probe {
+    void count_box() {}
+
+    void count_primitives(std::size_t) {}
+
+    void path_end(int) {}
+  };
+
+  // Contadores de rayos. Cada tesela acumula en uno propio que después se suma al total.
+  struct ray_stats {
+    std::uint64_t primary         = 0;
+    std::uint64_t secondary       = 0;
+    std::uint64_t shadow          = 0;  // el trazador no lanza rayos de sombra
+    std::uint64_t box_tests       = 0;  // nodos del BVH probados
+    std::uint64_t primitive_tests = 0;
+    std::vector<std::uint64_t> path_lengths;  // [k]: caminos que terminaron tras k segmentos
+
+    explicit ray_stats(int max_depth = 0);
+
+    void count_box() { ++box_tests; }
+
+    void count_primitives(std::size_t n) { primitive_tests += n; }
+
+    // Camino de segments rayos: el primero es primario y el resto secundarios
+    void path_end(int segments) {
+      ++primary;
+      secondary += static_cast<std::uint64_t>(segments - 1);
+      ++path_lengths[static_cast<std::size_t>(segments)];
+    }
+
+    void merge(ray_stats const & other);
+  };
+
+  // Estadísticas de un render: rayos y tiempo ocupado de cada hilo del pool
+  struct render_stats {
+    ray_stats rays;
+    std::vector<double> busy_seconds;  // por hilo
+    std::vector<std::uint64_t> tiles;  // teselas procesadas por hilo
+    double render_seconds = 0.0;
+
+    // Suma las estadísticas de otro render (varias pasadas de un mismo render progresivo)
+    void merge(render_stats const & other);
+  };
+
+  // Acumula en un render_stats lo medido en cada tesela. Seguro frente a llamadas concurrentes.
+  class tile_stats_sink {
+  public:
+    tile_stats_sink(render_stats & out, int max_depth, unsigned threads);
+
+    void add(ray_stats const & rays, unsigned worker, double seconds);
+
+  private:
+    std::mutex mtx;
+    render_stats & stats;
+  };
+
+  // Cronómetro de pared: mide desde su construcción
+  class stopwatch {
+  public:
+    [[nodiscard]] double seconds() const {
+      return std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    }
+
+  private:
+    std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+  };
+
+  // Tiempos de pared de cada fase del programa, en segundos
+  struct phase_times {
+    double config_parse = 0.0;
+    double scene_load   = 0.0;  // análisis del texto o lectura de la escena compilada
+    double scene_build  = 0.0;  // conversión al formato del motor, sin la jerarquía
+    double accel_build  = 0.0;
+    double render       = 0.0;  // incluye la escritura de las franjas que se solapa con él
+    double write        = 0.0;  // tiempo dentro del escritor de PPM
+  };
+
+  struct run_report {
+    std::string engine;
+    int width       = 0;
+    int height      = 0;
+    int samples     = 0;
+    int max_depth   = 0;
+    phase_times phases;
+    render_stats render;
+  };
+
+  // Informe en JSON: un objeto con las fases, los rayos y la ocupación de cada hilo
+  void write_stats_json(std::ostream & out, run_report const & report);
+
+}  // namespace render
+
+#endif
@@ -0,0 +1,62 @@
+#ifndef RENDER_THREAD_POOL_HPP
+#define RENDER_THREAD_POOL_HPP
+
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <exception>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <stop_token>
+#include <thread>
+#include <vector>
+
+namespace render {
+
+  // Conjunto persistente de hilos con una cola por hilo y robo de trabajo.
+  // Cada hilo consume su cola por delante; cuando se vacía roba por detrás de las demás.
+  class work_stealing_pool {
+  public:
+    explicit work_stealing_pool(unsigned threads);
+    ~work_stealing_pool();
+
+    work_stealing_pool(work_stealing_pool const &)             = delete;
+    work_stealing_pool & operator=(work_stealing_pool const &) = delete;
+
+    // Ejecuta task(i) para i en [0, count) y espera a que terminen todas.
+    // Relanza la primera excepción producida por una tarea.
+    void run(std::size_t count, std::function<void(std::size_t)> const & task);
+
+    [[nodiscard]] unsigned size() const { return static_cast<unsigned>(queues.size()); }
+
+    // Índice en su pool del hilo que hace la llamada (0 si no es un hilo de un pool)
+    [[nodiscard]] static unsigned current_worker();
+
+  private:
+    struct task_queue {
+      std::mutex mtx;
+      std::deque<std::size_t> tasks;
+    };
+
+    void worker_loop(std::stop_token const & stop, unsigned id);
+    bool next_task(unsigned id, std::size_t & task);
+
+    std::vector<std::unique_ptr<task_queue>> queues;
+    std::mutex mtx;
+    std::condition_variable_any start_cv;
+    std::condition_variable done_cv;
+    std::function<void(std::size_t)> const * current = nullptr;
+    std::uint64_t generation                          = 0;
+    std::size_t pending                               = 0;
+    std::exception_ptr error;
+    std::vector<std::jthread> workers;
+  };
+
+  // Número de hilos efectivo: requested si es positivo, si no los núcleos disponibles
+  unsigned resolve_thread_count(int requested);
+
+}  // namespace render
+
+#endif
@@ -0,0 +1,61 @@
+#ifndef RENDER_TILES_HPP
+#define RENDER_TILES_HPP
+
+#include "color.hpp"
+#include "framebuffer.hpp"
+
+#include <cstddef>
+#include <functional>
+#include <mutex>
+#include <span>
+#include <vector>
+
+namespace render {
+
+  // Tamaño de tesela fijo: no depende del número de hilos, así la imagen es determinista
+  inline constexpr int tile_size = 16;
+
+  // Rectángulo de la imagen que se renderiza como una unidad de trabajo
+  struct tile {
+    int row0;
+    int col0;
+    int rows;
+    int cols;
+  };
+
+  // Divide la imagen en teselas recorridas por filas
+  std::vector<tile> make_tiles(int width, int height, int size = tile_size);
+
+  // Recibe filas completas de píxeles, en orden y sin huecos
+  using row_sink = std::function<void(std::span<rgb8 const> rows)>;
+
+  // Sigue qué teselas han terminado y entrega a sink cada franja de filas, ya cuantizada con
+  // mapper, en cuanto ella y todas las anteriores están completas. Con sink vacío no hace nada.
+  class band_tracker {
+  public:
+    band_tracker(std::vector<tile> const & tiles, framebuffer const & image,
+                 tone_mapper const & mapper, row_sink sink);
+
+    // Seguro frente a llamadas concurrentes; sink se invoca con el cerrojo tomado
+    void tile_done(std::size_t t);
+
+  private:
+    struct band {
+      int row0;
+      int rows;
+      std::size_t remaining;
+    };
+
+    std::mutex mtx;
+    std::vector<band> bands;
+    std::vector<std::size_t> band_of_tile;
+    std::size_t next_band = 0;
+    framebuffer const & image;
+    tone_mapper const & mapper;
+    std::vector<rgb8> packed;  // franja en 8 bits que se entrega a sink
+    row_sink sink;
+  };
+
+}  // namespace render
+
+#endif
@@ -2,20 +2,130 @@
 #define RENDER_VECTOR_HPP
 
 #include <cmath>
+#include <concepts>
+#include <type_traits>
 
 namespace render {
 
-  class vector {
+  // Vector de tres componentes. La precisión se fija en compilación con el parámetro T:
+  // render::vector (double) es la que usa el renderizador y basic_vector<float> la de
+  // precisión simple. Todo está en línea para que el compilador pueda vectorizar los bucles.
+  template <std::floating_point T>
+  class basic_vector {
   public:
-    vector(double cx, double cy, double cz) : x{cx}, y{cy}, z{cz} {}
+    using scalar = T;
 
-    [[nodiscard]] double magnitude() const;
+    constexpr basic_vector() : x{0}, y{0}, z{0} {}
+
+    constexpr basic_vector(T cx, T cy, T cz) : x{cx}, y{cy}, z{cz} {}
+
+    // Conversión explícita entre precisiones
+    template <std::floating_point U>
+    constexpr explicit basic_vector(basic_vector<U> const & other)
+        : x{static_cast<T>(other.get_x())}, y{static_cast<T>(other.get_y())},
+          z{static_cast<T>(other.get_z())} {}
+
+    [[nodiscard]] constexpr T get_x() const { return x; }
+
+    [[nodiscard]] constexpr T get_y() const { return y; }
+
+    [[nodiscard]] constexpr T get_z() const { return z; }
+
+    [[nodiscard]] T magnitude() const { return std::sqrt(squared_magnitude()); }
+
+    [[nodiscard]] constexpr T squared_magnitude() const { return x * x + y * y + z * z; }
+
+    [[nodiscard]] basic_vector normalized() const {
+      T const m = magnitude();
+      return {x / m, y / m, z / m};
+    }
+
+    [[nodiscard]] constexpr T dot(basic_vector const & other) const {
+      return x * other.x + y * other.y + z * other.z;
+    }
+
+    [[nodiscard]] constexpr basic_vector cross(basic_vector const & other) const {
+      return {y * other.z - z * other.y, z * other.x - x * other.z, x * other.y - y * other.x};
+    }
+
+    // Producto componente a componente (atenuación de colores)
+    [[nodiscard]] constexpr basic_vector hadamard(basic_vector const & other) const {
+      return {x * other.x, y * other.y, z * other.z};
+    }
+
+    // Cierto si todas las componentes son prácticamente nulas
+    [[nodiscard]] constexpr bool near_zero() const {
+      constexpr T eps = static_cast<T>(1e-8);
+      return (abs(x) < eps) and (abs(y) < eps) and (abs(z) < eps);
+    }
+
+    constexpr basic_vector & operator+=(basic_vector const & other) {
+      x += other.x;
+      y += other.y;
+      z += other.z;
+      return *this;
+    }
+
+    constexpr basic_vector & operator-=(basic_vector const & other) {
+      x -= other.x;
+      y -= other.y;
+      z -= other.z;
+      return *this;
+    }
+
+    constexpr basic_vector & operator*=(T s) {
+      x *= s;
+      y *= s;
+      z *= s;
+      return *this;
+    }
+
+    constexpr basic_vector & operator/=(T s) {
+      x /= s;
+      y /= s;
+      z /= s;
+      return *this;
+    }
 
-    //...
   private:
-    double x, y, z;
+    // std::abs de coma flotante aún no es constexpr
+    static constexpr T abs(T v) { return (v < 0) ? -v : v; }
+
+    T x, y, z;
   };
 
+  template <std::floating_point T>
+  constexpr basic_vector<T> operator+(basic_vector<T> lhs, basic_vector<T> const & rhs) {
+    return lhs += rhs;
+  }
+
+  template <std::floating_point T>
+  constexpr basic_vector<T> operator-(basic_vector<T> lhs, basic_vector<T> const & rhs) {
+    return lhs -= rhs;
+  }
+
+  template <std::floating_point T>
+  constexpr basic_vector<T> operator-(basic_vector<T> const & v) {
+    return {-v.get_x(), -v.get_y(), -v.get_z()};
+  }
+
+  template <std::floating_point T>
+  constexpr basic_vector<T> operator*(basic_vector<T> lhs, std::type_identity_t<T> s) {
+    return lhs *= s;
+  }
+
+  template <std::floating_point T>
+  constexpr basic_vector<T> operator*(std::type_identity_t<T> s, basic_vector<T> rhs) {
+    return rhs *= s;
+  }
+
+  template <std::floating_point T>
+  constexpr basic_vector<T> operator/(basic_vector<T> lhs, std::type_identity_t<T> s) {
+    return lhs /= s;
+  }
+
+  using vector = basic_vector<double>;
+
 }  // namespace render
 
 #endif
@@ -0,0 +1,166 @@
+#ifndef RENDER_VECTOR_PACK_HPP
+#define RENDER_VECTOR_PACK_HPP
+
+#include "vector.hpp"
+
+#include <array>
+#include <cmath>
+#include <concepts>
+#include <cstddef>
+
+namespace render {
+
+  // N vectores en disposición SoA (una columna por componente) con las mismas operaciones que
+  // basic_vector<T>, aplicadas lane a lane. Los bucles tienen longitud fija y sin dependencias
+  // entre lanes, así que el compilador los convierte en instrucciones SIMD del ancho que
+  // permita el objetivo: un código escrito para un vector sirve para N a la vez.
+  template <std::size_t N, std::floating_point T = double>
+  struct vector3_pack {
+    using scalar = T;
+    using lanes  = std::array<T, N>;
+
+    static constexpr std::size_t width = N;
+
+    alignas(64) lanes x{};
+    alignas(64) lanes y{};
+    alignas(64) lanes z{};
+
+    // El mismo vector en todas las lanes
+    [[nodiscard]] static constexpr vector3_pack broadcast(basic_vector<T> const & v) {
+      vector3_pack p;
+      p.x.fill(v.get_x());
+      p.y.fill(v.get_y());
+      p.z.fill(v.get_z());
+      return p;
+    }
+
+    // Lee N elementos consecutivos de tres columnas
+    [[nodiscard]] static constexpr vector3_pack load(T const * xs, T const * ys, T const * zs) {
+      vector3_pack p;
+      for (std::size_t i = 0; i < N; ++i) {
+        p.x[i] = xs[i];
+        p.y[i] = ys[i];
+        p.z[i] = zs[i];
+      }
+      return p;
+    }
+
+    [[nodiscard]] constexpr basic_vector<T> lane(std::size_t i) const { return {x[i], y[i], z[i]}; }
+
+    constexpr void set_lane(std::size_t i, basic_vector<T> const & v) {
+      x[i] = v.get_x();
+      y[i] = v.get_y();
+      z[i] = v.get_z();
+    }
+
+    [[nodiscard]] constexpr lanes dot(vector3_pack const & other) const {
+      lanes out{};
+      for (std::size_t i = 0; i < N; ++i) {
+        out[i] = x[i] * other.x[i] + y[i] * other.y[i] + z[i] * other.z[i];
+      }
+      return out;
+    }
+
+    [[nodiscard]] constexpr lanes squared_magnitude() const { return dot(*this); }
+
+    [[nodiscard]] lanes magnitude() const {
+      lanes out = squared_magnitude();
+      for (auto & m : out) {
+        m = std::sqrt(m);
+      }
+      return out;
+    }
+
+    [[nodiscard]] vector3_pack normalized() const {
+      lanes const m = magnitude();
+      vector3_pack out;
+      for (std::size_t i = 0; i < N; ++i) {
+        out.x[i] = x[i] / m[i];
+        out.y[i] = y[i] / m[i];
+        out.z[i] = z[i] / m[i];
+      }
+      return out;
+    }
+
+    [[nodiscard]] constexpr vector3_pack cross(vector3_pack const & other) const {
+      vector3_pack out;
+      for (std::size_t i = 0; i < N; ++i) {
+        out.x[i] = y[i] * other.z[i] - z[i] * other.y[i];
+        out.y[i] = z[i] * other.x[i] - x[i] * other.z[i];
+        out.z[i] = x[i] * other.y[i] - y[i] * other.x[i];
+      }
+      return out;
+    }
+
+    [[nodiscard]] constexpr vector3_pack hadamard(vector3_pack const & other) const {
+      vector3_pack out;
+      for (std::size_t i = 0; i < N; ++i) {
+        out.x[i] = x[i] * other.x[i];
+        out.y[i] = y[i] * other.y[i];
+        out.z[i] = z[i] * other.z[i];
+      }
+      return out;
+    }
+
+    constexpr vector3_pack & operator+=(vector3_pack const & other) {
+      for (std::size_t i = 0; i < N; ++i) {
+        x[i] += other.x[i];
+        y[i] += other.y[i];
+        z[i] += other.z[i];
+      }
+      return *this;
+    }
+
+    constexpr vector3_pack & operator-=(vector3_pack const & other) {
+      for (std::size_t i = 0; i < N; ++i) {
+        x[i] -= other.x[i];
+        y[i] -= other.y[i];
+        z[i] -= other.z[i];
+      }
+      return *this;
+    }
+
+    // Escala cada lane por su propio factor
+    constexpr vector3_pack & operator*=(lanes const & s) {
+      for (std::size_t i = 0; i < N; ++i) {
+        x[i] *= s[i];
+        y[i] *= s[i];
+        z[i] *= s[i];
+      }
+      return *this;
+    }
+
+    constexpr vector3_pack & operator*=(T s) {
+      for (std::size_t i = 0; i < N; ++i) {
+        x[i] *= s;
+        y[i] *= s;
+        z[i] *= s;
+      }
+      return *this;
+    }
+  };
+
+  template <std::size_t N, std::floating_point T>
+  constexpr vector3_pack<N, T> operator+(vector3_pack<N, T> lhs, vector3_pack<N, T> const & rhs) {
+    return lhs += rhs;
+  }
+
+  template <std::size_t N, std::floating_point T>
+  constexpr vector3_pack<N, T> operator-(vector3_pack<N, T> lhs, vector3_pack<N, T> const & rhs) {
+    return lhs -= rhs;
+  }
+
+  template <std::size_t N, std::floating_point T>
+  constexpr vector3_pack<N, T> operator*(vector3_pack<N, T> lhs,
+                                         typename vector3_pack<N, T>::lanes const & s) {
+    return lhs *= s;
+  }
+
+  template <std::size_t N, std::floating_point T>
+  constexpr vector3_pack<N, T> operator*(vector3_pack<N, T> lhs, std::type_identity_t<T> s) {
+    return lhs *= s;
+  }
+
+}  // namespace render
+
+#endif
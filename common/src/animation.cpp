@@ -0,0 +1,106 @@
+#include "animation.hpp"
+#include "mapped_file.hpp"
+#include "vector.hpp"
+
+#include <array>
+#include <cmath>
+#include <numbers>
+#include <stdexcept>
+#include <string_view>
+
+namespace render {
+
+  namespace {
+
+    vector to_vector(std::array<double, 3> const & a) { return {a[0], a[1], a[2]}; }
+
+    std::array<double, 3> to_array(vector const & v) { return {v.get_x(), v.get_y(), v.get_z()}; }
+
+    // Cierto si la línea, sin blancos alrededor, es exactamente "frame:"
+    bool is_frame_marker(std::string_view line) {
+      auto const first = line.find_first_not_of(" \t\r\v\f");
+      if (first == std::string_view::npos) {
+        return false;
+      }
+      auto const last = line.find_last_not_of(" \t\r\v\f");
+      return line.substr(first, last - first + 1) == "frame:";
+    }
+
+  }  // namespace
+
+  std::vector<Config> load_frames(Config const & base, std::string const & path) {
+    mapped_file const file(path);
+    std::vector<Config> frames;
+    Config common         = base;
+    std::string_view text = file.view();
+    while (not text.empty()) {
+      auto const nl               = text.find('\n');
+      std::string_view const line = text.substr(0, nl);
+      if (is_frame_marker(line)) {
+        Config const next = frames.empty() ? common : frames.back();
+        frames.push_back(next);
+      } else {
+        parseConfigLine(line, frames.empty() ? common : frames.back());
+      }
+      text.remove_prefix((nl == std::string_view::npos) ? text.size() : nl + 1);
+    }
+    if (frames.empty()) {
+      throw std::runtime_error("Error: No frames in file: [" + path + "]");
+    }
+    return frames;
+  }
+
+  std::vector<Config> turntable_frames(Config const & base, int count) {
+    // Rotación de Rodrigues de la componente radial del desplazamiento alrededor del eje
+    vector const target = to_vector(base.camera_target);
+    vector const axis   = to_vector(base.camera_north).normalized();
+    vector const offset = to_vector(base.camera_position) - target;
+    double const height = offset.dot(axis);
+    vector const radial = offset - axis * height;
+    vector const side   = axis.cross(radial);
+
+    std::vector<Config> frames;
+    frames.reserve(static_cast<std::size_t>(count));
+    for (int k = 0; k < count; ++k) {
+      double const angle = 2.0 * std::numbers::pi * k / count;
+      Config frame       = base;
+      if (k > 0) {
+        frame.camera_position = to_array(target + axis * height + radial * std::cos(angle) +
+                                         side * std::sin(angle));
+      }
+      frames.push_back(frame);
+    }
+    return frames;
+  }
+
+  std::vector<Config> batch_frames(options const & opts, Config const & base) {
+    if (opts.frames.empty() and (opts.turntable == 0)) {
+      return {};
+    }
+    if (not opts.frames.empty() and (opts.turntable != 0)) {
+      throw std::runtime_error("Error: Options --frames and --turntable are exclusive");
+    }
+    if (not opts.checkpoint.empty()) {
+      throw std::runtime_error("Error: Option --checkpoint renders a single image");
+    }
+    return opts.frames.empty() ? turntable_frames(base, opts.turntable)
+                               : load_frames(base, opts.frames);
+  }
+
+  std::string frame_path(std::string const & pattern, std::size_t frame) {
+    auto const first = pattern.find('#');
+    if (first == std::string::npos) {
+      throw std::runtime_error("Error: Output pattern has no frame number: [" + pattern + "]");
+    }
+    auto last = pattern.find_first_not_of('#', first);
+    if (last == std::string::npos) {
+      last = pattern.size();
+    }
+    std::string number = std::to_string(frame);
+    if (number.size() < last - first) {
+      number.insert(0, last - first - number.size(), '0');
+    }
+    return pattern.substr(0, first) + number + pattern.substr(last);
+  }
+
+}  // namespace render
@@ -0,0 +1,313 @@
+#include "bvh.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <stdexcept>
+#include <utility>
+
+namespace render {
+
+  namespace {
+
+    constexpr std::size_t bin_count = 16;
+
+    // Coste relativo de atravesar un nodo frente a intersecar un primitivo
+    constexpr double traversal_cost = 1.0;
+
+    // Margen para que las cajas sean conservadoras frente al redondeo del test de losas
+    constexpr double bounds_padding = 1e-9;
+
+    aabb empty_box() {
+      constexpr double inf = std::numeric_limits<double>::infinity();
+      return {
+        {inf, inf, inf},
+        {-inf, -inf, -inf}
+      };
+    }
+
+    aabb padded(aabb box) {
+      for (std::size_t k = 0; k < 3; ++k) {
+        double const pad = bounds_padding * (1.0 + std::abs(box.lo[k]) + std::abs(box.hi[k]));
+        box.lo[k] -= pad;
+        box.hi[k] += pad;
+      }
+      return box;
+    }
+
+    double centroid(aabb const & box, std::size_t axis) {
+      return 0.5 * (box.lo[axis] + box.hi[axis]);
+    }
+
+    struct bin {
+      aabb box          = empty_box();
+      std::size_t count = 0;
+    };
+
+    struct split {
+      std::size_t axis = 0;
+      std::size_t bin  = 0;
+      double cost      = std::numeric_limits<double>::infinity();
+    };
+
+    class builder {
+    public:
+      builder(std::vector<aabb> const & bnds, std::size_t leaf_size, std::vector<bvh_node> & out,
+              std::vector<std::uint32_t> & perm)
+          : bounds{bnds}, max_leaf{leaf_size}, nodes{out}, order{perm} {}
+
+      void build(std::size_t first, std::size_t last, std::size_t depth) {
+        std::size_t const node_idx = nodes.size();
+        nodes.emplace_back();
+
+        aabb box          = empty_box();
+        aabb centroid_box = empty_box();
+        for (std::size_t i = first; i < last; ++i) {
+          aabb const & b = bounds[order[i]];
+          box.expand(b);
+          for (std::size_t k = 0; k < 3; ++k) {
+            double const c     = centroid(b, k);
+            centroid_box.lo[k] = std::min(centroid_box.lo[k], c);
+            centroid_box.hi[k] = std::max(centroid_box.hi[k], c);
+          }
+        }
+        nodes[node_idx].lo = box.lo;
+        nodes[node_idx].hi = box.hi;
+
+        std::size_t const count = last - first;
+        if ((count <= 1) or (depth >= bvh::max_depth)) {
+          make_leaf(node_idx, first, count);
+          return;
+        }
+
+        split const best       = find_split(first, last, box, centroid_box);
+        double const leaf_cost = static_cast<double>(count);
+        std::size_t mid        = first;
+        if (std::isfinite(best.cost)) {
+          if ((best.cost >= leaf_cost) and (count <= max_leaf)) {
+            make_leaf(node_idx, first, count);
+            return;
+          }
+          mid = partition(first, last, best, centroid_box);
+        } else if (count <= max_leaf) {
+          make_leaf(node_idx, first, count);
+          return;
+        }
+        if ((mid == first) or (mid == last)) {
+          // Centroides coincidentes: se parte por la mitad
+          mid = first + count / 2;
+        }
+        if (std::max(mid - first, last - mid) > leaf_capacity(depth + 1)) {
+          // Partición muy desequilibrada: con los niveles que quedan la hoja forzada en la
+          // profundidad máxima no cabría en bvh_node::count, así que se parte por la mitad
+          mid = first + count / 2;
+        }
+
+        nodes[node_idx].axis = static_cast<std::uint16_t>(best.axis);
+        build(first, mid, depth + 1);
+        nodes[node_idx].offset = static_cast<std::uint32_t>(nodes.size());
+        build(mid, last, depth + 1);
+      }
+
+    private:
+      // Primitivos que caben bajo un nodo de esa profundidad partiendo siempre por la mitad
+      static std::size_t leaf_capacity(std::size_t depth) {
+        return std::size_t{std::numeric_limits<std::uint16_t>::max()} << (bvh::max_depth - depth);
+      }
+
+      void make_leaf(std::size_t node_idx, std::size_t first, std::size_t count) {
+        nodes[node_idx].offset = static_cast<std::uint32_t>(first);
+        nodes[node_idx].count  = static_cast<std::uint16_t>(count);
+      }
+
+      static std::size_t bin_of(double c, double lo, double scale) {
+        auto const b = static_cast<std::size_t>((c - lo) * scale);
+        return std::min(b, bin_count - 1);
+      }
+
+      split find_split(std::size_t first, std::size_t last, aabb const & box,
+                       aabb const & centroid_box) const {
+        split best;
+        double const parent_area = box.surface_area();
+        for (std::size_t axis = 0; axis < 3; ++axis) {
+          double const extent = centroid_box.hi[axis] - centroid_box.lo[axis];
+          if (not(extent > 0.0)) {
+            continue;
+          }
+          double const scale = static_cast<double>(bin_count) / extent;
+          std::array<bin, bin_count> bins{};
+          for (std::size_t i = first; i < last; ++i) {
+            aabb const & b = bounds[order[i]];
+            auto & bn      = bins[bin_of(centroid(b, axis), centroid_box.lo[axis], scale)];
+            bn.box.expand(b);
+            ++bn.count;
+          }
+
+          // Barrido por la derecha acumulando área y número de primitivos
+          std::array<double, bin_count> right_cost{};
+          aabb acc          = empty_box();
+          std::size_t n_acc = 0;
+          for (std::size_t b = bin_count - 1; b > 0; --b) {
+            acc.expand(bins[b].box);
+            n_acc += bins[b].count;
+            if (n_acc > 0) {
+              right_cost[b] = acc.surface_area() * static_cast<double>(n_acc);
+            }
+          }
+          acc   = empty_box();
+          n_acc = 0;
+          for (std::size_t b = 0; b + 1 < bin_count; ++b) {
+            acc.expand(bins[b].box);
+            n_acc += bins[b].count;
+            if ((n_acc == 0) or (n_acc == last - first)) {
+              continue;
+            }
+            double const cost =
+                traversal_cost +
+                (acc.surface_area() * static_cast<double>(n_acc) + right_cost[b + 1]) /
+                    parent_area;
+            if (cost < best.cost) {
+              best = {axis, b, cost};
+            }
+          }
+        }
+        return best;
+      }
+
+      std::size_t partition(std::size_t first, std::size_t last, split const & s,
+                            aabb const & centroid_box) {
+        double const lo    = centroid_box.lo[s.axis];
+        double const scale = static_cast<double>(bin_count) / (centroid_box.hi[s.axis] - lo);
+        auto const begin   = order.begin() + static_cast<std::ptrdiff_t>(first);
+        auto const end     = order.begin() + static_cast<std::ptrdiff_t>(last);
+        auto const mid     = std::stable_partition(begin, end, [&](std::uint32_t idx) {
+          return bin_of(centroid(bounds[idx], s.axis), lo, scale) <= s.bin;
+        });
+        return static_cast<std::size_t>(mid - order.begin());
+      }
+
+      std::vector<aabb> const & bounds;
+      std::size_t max_leaf;
+      std::vector<bvh_node> & nodes;
+      std::vector<std::uint32_t> & order;
+    };
+
+  }  // namespace
+
+  accel_kind parse_accel(std::string const & name) {
+    if (name == "none") {
+      return accel_kind::none;
+    }
+    if (name == "bvh") {
+      return accel_kind::bvh;
+    }
+    throw std::runtime_error("Error: Invalid acceleration structure: [" + name + "]");
+  }
+
+  void aabb::expand(aabb const & other) {
+    for (std::size_t k = 0; k < 3; ++k) {
+      lo[k] = std::min(lo[k], other.lo[k]);
+      hi[k] = std::max(hi[k], other.hi[k]);
+    }
+  }
+
+  double aabb::surface_area() const {
+    double const dx = hi[0] - lo[0];
+    double const dy = hi[1] - lo[1];
+    double const dz = hi[2] - lo[2];
+    return 2.0 * (dx * dy + dy * dz + dz * dx);
+  }
+
+  aabb sphere_bounds(vector const & center, double radius) {
+    return padded({
+      {center.get_x() - radius, center.get_y() - radius, center.get_z() - radius},
+      {center.get_x() + radius, center.get_y() + radius, center.get_z() + radius}
+    });
+  }
+
+  aabb cylinder_bounds(vector const & center, double radius, vector const & axis,
+                       double half_height) {
+    // Caja de los dos discos de las tapas: en el eje k el disco se extiende r * sqrt(1 - a_k^2)
+    std::array<double, 3> const c = {center.get_x(), center.get_y(), center.get_z()};
+    std::array<double, 3> const a = {axis.get_x(), axis.get_y(), axis.get_z()};
+    aabb box{};
+    for (std::size_t k = 0; k < 3; ++k) {
+      double const disc = radius * std::sqrt(std::max(0.0, 1.0 - a[k] * a[k]));
+      double const e0   = c[k] - a[k] * half_height;
+      double const e1   = c[k] + a[k] * half_height;
+      box.lo[k]         = std::min(e0, e1) - disc;
+      box.hi[k]         = std::max(e0, e1) + disc;
+    }
+    return padded(box);
+  }
+
+  bvh_ray::bvh_ray(ray const & r)
+      : origin{r.origin.get_x(), r.origin.get_y(), r.origin.get_z()},
+        inv_dir{1.0 / r.direction.get_x(), 1.0 / r.direction.get_y(), 1.0 / r.direction.get_z()},
+        negative{std::signbit(r.direction.get_x()), std::signbit(r.direction.get_y()),
+                 std::signbit(r.direction.get_z())} {}
+
+  bvh::bvh(std::vector<aabb> const & bounds, std::size_t max_leaf_size) {
+    if (bounds.empty()) {
+      return;
+    }
+    order.resize(bounds.size());
+    for (std::size_t i = 0; i < order.size(); ++i) {
+      order[i] = static_cast<std::uint32_t>(i);
+    }
+    nodes.reserve(2 * bounds.size());
+    std::size_t const leaf_size = std::clamp<std::size_t>(max_leaf_size, 1, UINT16_MAX);
+    builder(bounds, leaf_size, nodes, order).build(0, bounds.size(), 0);
+  }
+
+  void bvh::refit(std::vector<aabb> const & bounds) {
+    // Los hijos de un nodo están siempre detrás de él en el array
+    for (std::size_t i = nodes.size(); i-- > 0;) {
+      bvh_node & node = nodes[i];
+      aabb box        = empty_box();
+      if (node.count > 0) {
+        for (std::size_t p = node.offset; p < std::size_t{node.offset} + node.count; ++p) {
+          box.expand(bounds[p]);
+        }
+      } else {
+        bvh_node const & left  = nodes[i + 1];
+        bvh_node const & right = nodes[node.offset];
+        box                    = {left.lo, left.hi};
+        box.expand({right.lo, right.hi});
+      }
+      node.lo = box.lo;
+      node.hi = box.hi;
+    }
+  }
+
+  bvh::bvh(std::vector<bvh_node> flat_nodes, std::vector<std::uint32_t> leaf_order)
+      : nodes{std::move(flat_nodes)}, order{std::move(leaf_order)} {
+    auto const invalid = [] { return std::runtime_error("Error: Invalid BVH layout"); };
+    if (nodes.empty() != order.empty()) {
+      throw invalid();
+    }
+    for (std::uint32_t const idx : order) {
+      if (idx >= order.size()) {
+        throw invalid();
+      }
+    }
+    // Los hijos siempre siguen al padre, así que la profundidad se propaga en una pasada
+    std::vector<std::size_t> depth(nodes.size(), 0);
+    for (std::size_t i = 0; i < nodes.size(); ++i) {
+      bvh_node const & node = nodes[i];
+      if (node.count > 0) {
+        if (std::size_t{node.offset} + node.count > order.size()) {
+          throw invalid();
+        }
+        continue;
+      }
+      if ((depth[i] >= max_depth) or (node.axis > 2) or (i + 1 >= nodes.size()) or
+          (node.offset <= i + 1) or (node.offset >= nodes.size())) {
+        throw invalid();
+      }
+      depth[i + 1]       = std::max(depth[i + 1], depth[i] + 1);
+      depth[node.offset] = std::max(depth[node.offset], depth[i] + 1);
+    }
+  }
+
+}  // namespace render
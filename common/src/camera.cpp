@@ -0,0 +1,49 @@
+#include "camera.hpp"
+
+#include <array>
+#include <cmath>
+#include <numbers>
+
+namespace render {
+
+  namespace {
+
+    vector to_vector(std::array<double, 3> const & a) {
+      return {a[0], a[1], a[2]};
+    }
+
+  }  // namespace
+
+  camera::camera(Config const & cfg, int width, int height)
+      : position{to_vector(cfg.camera_position)} {
+    vector const target = to_vector(cfg.camera_target);
+    vector const north  = to_vector(cfg.camera_north);
+
+    vector const forward  = position - target;
+    double const distance = forward.magnitude();
+    double const theta    = cfg.field_of_view * std::numbers::pi / 180.0;
+    double const h_p      = 2.0 * std::tan(theta / 2.0) * distance;
+    double const w_p      = h_p * static_cast<double>(width) / static_cast<double>(height);
+
+    vector const u = north.cross(forward).normalized();
+    vector const v = forward.normalized().cross(u);
+
+    vector const horizontal = u * w_p;
+    vector const vertical   = -v * h_p;
+
+    delta_x = horizontal / static_cast<double>(width);
+    delta_y = vertical / static_cast<double>(height);
+    origin  = position - forward - (horizontal + vertical) / 2.0;
+  }
+
+  ray camera::primary_ray(int row, int col, double dx, double dy) const {
+    vector const q = origin + delta_x * (static_cast<double>(col) + 0.5 + dx) +
+                     delta_y * (static_cast<double>(row) + 0.5 + dy);
+    return {position, (q - position).normalized()};
+  }
+
+  int image_height(Config const & cfg) {
+    return (cfg.image_width * cfg.aspect_ratio.second) / cfg.aspect_ratio.first;
+  }
+
+}  // namespace render
@@ -0,0 +1,27 @@
+#include "checksum.hpp"
+
+#include <bit>
+#include <cstring>
+
+namespace render {
+
+  // Mezcla palabra a palabra: rotación y producto por una constante impar son biyectivos, así
+  // que cualquier cambio en un único byte altera el resultado. Varios GB/s en un solo hilo.
+  std::uint64_t checksum(std::string_view bytes) {
+    std::uint64_t h     = 0x9e37'79b9'7f4a'7c15ULL;
+    std::size_t i       = 0;
+    auto const mix_word = [&h](std::uint64_t w) {
+      h = std::rotl(h ^ w, 27) * 0x0000'0100'0000'01b3ULL;
+    };
+    for (; i + 8 <= bytes.size(); i += 8) {
+      std::uint64_t w = 0;
+      std::memcpy(&w, bytes.data() + i, sizeof(w));
+      mix_word(w);
+    }
+    std::uint64_t tail = 0;
+    std::memcpy(&tail, bytes.data() + i, bytes.size() - i);
+    mix_word(tail ^ bytes.size());
+    return h ^ (h >> 31);
+  }
+
+}  // namespace render
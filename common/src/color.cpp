@@ -0,0 +1,64 @@
+#include "color.hpp"
+
+#include <algorithm>
+#include <bit>
+#include <cmath>
+#include <cstdint>
+
+namespace render {
+
+  int to_u8(double v, double gamma) {
+    v                = std::clamp(v, 0.0, 1.0);
+    double corrected = std::pow(v, 1.0 / gamma);
+    int iv           = static_cast<int>(std::floor(corrected * 255.0 + 0.5));
+    return std::clamp(iv, 0, 255);
+  }
+
+  std::array<int, 3> to_rgb8(vector const & c, double gamma) {
+    return {to_u8(c.get_x(), gamma), to_u8(c.get_y(), gamma), to_u8(c.get_z(), gamma)};
+  }
+
+  tone_mapper::tone_mapper(double gamma_value)
+      : gamma{gamma_value}, table{std::isfinite(gamma_value) and (gamma_value > 0.0)} {
+    if (not table) {
+      return;
+    }
+    bucket_level.assign(bucket_count, 0);
+    // Los dobles positivos se ordenan igual que su representación binaria: la bisección sobre
+    // los bits encuentra el umbral exacto en unas 62 evaluaciones
+    auto const lo_bits = std::bit_cast<std::uint64_t>(0.0);
+    auto const hi_bits = std::bit_cast<std::uint64_t>(1.0);
+    for (int k = 1; k <= max_level; ++k) {
+      std::uint64_t lo = lo_bits;
+      std::uint64_t hi = hi_bits;
+      while (hi - lo > 1) {
+        std::uint64_t const mid = lo + (hi - lo) / 2;
+        if (render::to_u8(std::bit_cast<double>(mid), gamma) >= k) {
+          hi = mid;
+        } else {
+          lo = mid;
+        }
+      }
+      thresholds[static_cast<std::size_t>(k)] = std::bit_cast<double>(hi);
+    }
+
+    // v * bucket_count puede redondear al intervalo siguiente: se parte del nivel del anterior
+    for (std::size_t b = 1; b < bucket_count; ++b) {
+      double const start = static_cast<double>(b - 1) / static_cast<double>(bucket_count);
+      int level          = bucket_level[b - 1];
+      while ((level < max_level) and (start >= thresholds[static_cast<std::size_t>(level) + 1])) {
+        ++level;
+      }
+      bucket_level[b] = static_cast<std::uint8_t>(level);
+    }
+  }
+
+  void tone_mapper::convert(std::span<float const> linear, std::span<rgb8> out) const {
+    for (std::size_t i = 0; i < out.size(); ++i) {
+      float const * const p = &linear[3 * i];
+      out[i] = {static_cast<std::uint8_t>(to_u8(p[0])), static_cast<std::uint8_t>(to_u8(p[1])),
+                static_cast<std::uint8_t>(to_u8(p[2]))};
+    }
+  }
+
+}  // namespace render
@@ -0,0 +1,24 @@
+#include "framebuffer.hpp"
+
+namespace render {
+
+  framebuffer::framebuffer(int width, int height)
+      : width{width}, height{height},
+        linear(3 * static_cast<std::size_t>(width) * static_cast<std::size_t>(height), 0.0F) {}
+
+  std::span<float const> framebuffer::rows(int row0, int count) const {
+    return std::span<float const>(linear).subspan(3 * index(row0, 0), 3 * index(count, 0));
+  }
+
+  void framebuffer::pack_rows(int row0, int count, tone_mapper const & mapper,
+                              std::span<rgb8> out) const {
+    mapper.convert(rows(row0, count), out);
+  }
+
+  std::vector<rgb8> framebuffer::pack(tone_mapper const & mapper) const {
+    std::vector<rgb8> out(index(height, 0));
+    pack_rows(0, height, mapper, out);
+    return out;
+  }
+
+}  // namespace render
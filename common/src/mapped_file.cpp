@@ -0,0 +1,58 @@
+#include "mapped_file.hpp"
+
+#include <array>
+#include <fcntl.h>
+#include <stdexcept>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+namespace render {
+
+  namespace {
+
+    // Lee hasta fin de fichero; un error de lectura (p. ej. un directorio) se trata como fin
+    std::string read_all(int fd) {
+      std::string data;
+      std::array<char, 1 << 16> chunk{};
+      while (true) {
+        ssize_t const n = ::read(fd, chunk.data(), chunk.size());
+        if (n <= 0) {
+          return data;
+        }
+        data.append(chunk.data(), static_cast<std::size_t>(n));
+      }
+    }
+
+  }  // namespace
+
+  mapped_file::mapped_file(std::string const & path) {
+    int const fd = ::open(path.c_str(), O_RDONLY | O_CLOEXEC);
+    if (fd < 0) {
+      throw std::runtime_error("No se pudo abrir archivo: " + path);
+    }
+    struct stat st{};
+    if ((::fstat(fd, &st) == 0) and S_ISREG(st.st_mode) and (st.st_size > 0)) {
+      auto const size = static_cast<std::size_t>(st.st_size);
+      void * const p  = ::mmap(nullptr, size, PROT_READ, MAP_PRIVATE, fd, 0);
+      if (p != MAP_FAILED) {
+        ::madvise(p, size, MADV_SEQUENTIAL);
+        mapping     = p;
+        mapped_size = size;
+        contents    = std::string_view(static_cast<char const *>(p), size);
+      }
+    }
+    if (mapping == nullptr) {
+      buffer   = read_all(fd);
+      contents = buffer;
+    }
+    ::close(fd);
+  }
+
+  mapped_file::~mapped_file() {
+    if (mapping != nullptr) {
+      ::munmap(mapping, mapped_size);
+    }
+  }
+
+}  // namespace render
@@ -0,0 +1,98 @@
+#include "options.hpp"
+
+#include <charconv>
+#include <stdexcept>
+#include <string_view>
+
+namespace render {
+
+  namespace {
+
+    // Entero no negativo sin caracteres sobrantes
+    int parse_count(std::string const & name, std::string const & value) {
+      int n           = 0;
+      auto const last = value.data() + value.size();
+      auto const [ptr, ec] = std::from_chars(value.data(), last, n);
+      if ((ec != std::errc{}) or (ptr != last) or (n < 0)) {
+        throw std::runtime_error("Error: Invalid value for option: [" + name + "]");
+      }
+      return n;
+    }
+
+    void dispatch_option(std::string const & name, std::string const & value, options & opts) {
+      if (name == "--simd") {
+        opts.simd = value;
+      } else if (name == "--integrator") {
+        opts.integrator = value;
+      } else if (name == "--precision") {
+        opts.precision = value;
+      } else if (name == "--accel") {
+        opts.accel = value;
+      } else if (name == "--format") {
+        opts.format = value;
+      } else if (name == "--threads") {
+        opts.threads = parse_count(name, value);
+      } else if (name == "--compile-scene") {
+        if (value.empty()) {
+          throw std::runtime_error("Error: Invalid value for option: [" + name + "]");
+        }
+        opts.compile_scene = value;
+      } else if (name == "--stats") {
+        if (value.empty()) {
+          throw std::runtime_error("Error: Invalid value for option: [" + name + "]");
+        }
+        opts.stats = value;
+      } else if (name == "--checkpoint") {
+        if (value.empty()) {
+          throw std::runtime_error("Error: Invalid value for option: [" + name + "]");
+        }
+        opts.checkpoint = value;
+      } else if (name == "--frames") {
+        if (value.empty()) {
+          throw std::runtime_error("Error: Invalid value for option: [" + name + "]");
+        }
+        opts.frames = value;
+      } else if (name == "--turntable") {
+        opts.turntable = parse_count(name, value);
+        if (opts.turntable == 0) {
+          throw std::runtime_error("Error: Invalid value for option: [" + name + "]");
+        }
+      } else if (name == "--serve") {
+        if (value.empty()) {
+          throw std::runtime_error("Error: Invalid value for option: [" + name + "]");
+        }
+        opts.serve = value;
+      } else if (name == "--scene-cache") {
+        opts.scene_cache = parse_count(name, value);
+      } else if (name == "--pass-samples") {
+        opts.pass_samples = parse_count(name, value);
+        if (opts.pass_samples == 0) {
+          throw std::runtime_error("Error: Invalid value for option: [" + name + "]");
+        }
+      } else if (name == "--checkpoint-interval") {
+        opts.checkpoint_interval = parse_count(name, value);
+      } else {
+        throw std::runtime_error("Error: Unknown option: [" + name + "]");
+      }
+    }
+
+  }  // namespace
+
+  options parse_options(std::span<char *> args) {
+    options opts;
+    for (std::size_t i = 1; i < args.size(); ++i) {
+      std::string_view const arg = args[i];
+      if (not arg.starts_with("--")) {
+        opts.positional.emplace_back(arg);
+        continue;
+      }
+      auto const eq = arg.find('=');
+      if (eq == std::string_view::npos) {
+        throw std::runtime_error("Error: Missing value for option: [" + std::string(arg) + "]");
+      }
+      dispatch_option(std::string(arg.substr(0, eq)), std::string(arg.substr(eq + 1)), opts);
+    }
+    return opts;
+  }
+
+}  // namespace render
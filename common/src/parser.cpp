@@ -1,67 +1,127 @@
 #include "parser.hpp"
+#include "mapped_file.hpp"
 #include <algorithm>
-#include <cctype>
-#include <fstream>
-#include <iostream>
-#include <sstream>
+#include <charconv>
+#include <cmath>
+#include <cstdint>
+#include <exception>
+#include <functional>
+#include <limits>
 #include <stdexcept>
+#include <string_view>
+#include <system_error>
+#include <unordered_map>
+
+// Los ficheros se proyectan en memoria y se recorren sin copias: cada línea y cada token son
+// std::string_view sobre el fichero, y los números se convierten con std::from_chars.
+// Solo se crean std::string para los datos que se guardan y para los mensajes de error.
 
 // --- helpers ---
 namespace {
 
-  std::string trim(std::string const & s) {
-    size_t a = 0, b = s.size();
-    while ((a < b) and (std::isspace(static_cast<unsigned char>(s[a])) != 0)) {
-      ++a;
-    }
-    while ((b > a) and (std::isspace(static_cast<unsigned char>(s[b - 1])) != 0)) {
-      --b;
-    }
-    return s.substr(a, b - a);
-  }
+  using token_list = std::vector<std::string_view>;
 
-  bool is_blank(std::string const & s) {
-    return std::ranges::all_of(
-        s, [](char c) { return std::isspace(static_cast<unsigned char>(c)) != 0; });
+  // Mismos separadores que std::isspace en la configuración regional "C"
+  bool is_space(char c) {
+    return (c == ' ') or (c == '\t') or (c == '\n') or (c == '\v') or (c == '\f') or (c == '\r');
   }
 
-  std::vector<std::string> split_ws(std::string const & line) {
-    std::istringstream iss(line);
-    std::vector<std::string> toks;
-    std::string tok;
-    while (iss >> tok) {
-      toks.push_back(tok);
+  // Llama a f con cada línea, sin el '\n' final (mismas líneas que std::getline)
+  template <typename F>
+  void for_each_line(std::string_view text, F && f) {
+    while (not text.empty()) {
+      auto const nl = text.find('\n');
+      f(text.substr(0, nl));
+      if (nl == std::string_view::npos) {
+        return;
+      }
+      text.remove_prefix(nl + 1);
     }
-    return toks;
   }
 
-  double parse_double_strict(std::string const & tok) {
-    try {
-      size_t pos = 0;
-      double v   = std::stod(tok, &pos);
-      if (pos != tok.size()) {
-        throw std::invalid_argument("trailing");
+  // Separa la línea en tokens reutilizando la capacidad de toks entre líneas
+  void split_ws(std::string_view line, token_list & toks) {
+    toks.clear();
+    std::size_t i = 0;
+    while (i < line.size()) {
+      while ((i < line.size()) and is_space(line[i])) {
+        ++i;
+      }
+      std::size_t const start = i;
+      while ((i < line.size()) and not is_space(line[i])) {
+        ++i;
+      }
+      if (i > start) {
+        toks.push_back(line.substr(start, i - start));
       }
-      return v;
-    } catch (...) {
-      throw;
     }
   }
 
-  int parse_int_strict(std::string const & tok) {
-    try {
-      size_t pos = 0;
-      int v      = std::stoi(tok, &pos);
-      if (pos != tok.size()) {
-        throw std::invalid_argument("trailing");
+  // Signo opcional como en strtod/strtol: from_chars no admite '+'
+  bool take_sign(std::string_view & tok, char const * what) {
+    bool negative = false;
+    if (tok.starts_with('+') or tok.starts_with('-')) {
+      negative = tok.front() == '-';
+      tok.remove_prefix(1);
+      if (tok.starts_with('+') or tok.starts_with('-')) {
+        throw std::invalid_argument(what);
       }
-      return v;
-    } catch (...) {
-      throw;
     }
+    return negative;
+  }
+
+  // Reproduce std::stod: invalid_argument("stod") u out_of_range("stod"), e invalid_argument
+  // ("trailing") si sobran caracteres. Se aceptan también los literales hexadecimales.
+  double parse_double_strict(std::string_view tok) {
+    bool const negative = take_sign(tok, "stod");
+    auto fmt            = std::chars_format::general;
+    bool hex            = false;
+    if ((tok.size() >= 2) and (tok[0] == '0') and ((tok[1] == 'x') or (tok[1] == 'X'))) {
+      tok.remove_prefix(2);
+      fmt = std::chars_format::hex;
+      hex = true;
+    }
+    double v             = 0.0;
+    auto const last      = tok.data() + tok.size();
+    auto const [ptr, ec] = std::from_chars(tok.data(), last, v, fmt);
+    if (ec == std::errc::invalid_argument) {
+      // "0x" sin dígitos: strtod lee el 0 y deja la 'x' sin consumir
+      throw std::invalid_argument(hex ? "trailing" : "stod");
+    }
+    // strtod también da ERANGE con los subnormales, que from_chars sí acepta
+    bool const subnormal = (v != 0.0) and (std::abs(v) < std::numeric_limits<double>::min());
+    if ((ec == std::errc::result_out_of_range) or subnormal) {
+      throw std::out_of_range("stod");
+    }
+    if (ptr != last) {
+      throw std::invalid_argument("trailing");
+    }
+    return negative ? -v : v;
+  }
+
+  // Reproduce std::stoi con las mismas excepciones que parse_double_strict
+  int parse_int_strict(std::string_view tok) {
+    std::string_view digits = tok;
+    bool const negative     = take_sign(digits, "stoi");
+    if (negative) {
+      digits = tok;  // from_chars admite el '-' y así cubre INT_MIN
+    }
+    int v                = 0;
+    auto const last      = digits.data() + digits.size();
+    auto const [ptr, ec] = std::from_chars(digits.data(), last, v);
+    if (ec == std::errc::invalid_argument) {
+      throw std::invalid_argument("stoi");
+    }
+    if (ec == std::errc::result_out_of_range) {
+      throw std::out_of_range("stoi");
+    }
+    if (ptr != last) {
+      throw std::invalid_argument("trailing");
+    }
+    return v;
   }
 
-  std::string join_from(std::vector<std::string> const & toks, size_t i) {
+  std::string join_from(token_list const & toks, size_t i) {
     std::string r;
     for (size_t j = i; j < toks.size(); ++j) {
       if (j > i) {
@@ -72,284 +132,137 @@ namespace {
     return r;
   }
 
+  // Final común de los mensajes de error: la línea original entre comillas
+  std::string line_info(std::string_view raw) {
+    std::string r = "\nLine: \"";
+    r += raw;
+    r += "\"";
+    return r;
+  }
+
+  std::string extra_data(token_list const & toks, size_t i, std::string_view raw) {
+    std::string r = "Error: Extra data after configuration value for key: [";
+    r += toks[0];
+    r += "]\nExtra: \"";
+    r += join_from(toks, i);
+    r += "\"";
+    r += line_info(raw);
+    return r;
+  }
+
 }  // anonymous namespace
 
 // --- parseConfig ---
 namespace {
 
-  void parse_image_width(std::vector<std::string> const & toks, std::string const & raw,
-                         Config & cfg) {
-    if (toks.size() < 2) {
-      throw std::runtime_error(
-          "Error: Invalid value for key: [image_width:]\nLine: \"" + raw + "\"");
+  [[noreturn]] void invalid_value(token_list const & toks, std::string_view raw) {
+    throw std::runtime_error("Error: Invalid value for key: [" + std::string(toks[0]) + "]" +
+                             line_info(raw));
+  }
+
+  // La clave debe ir seguida exactamente de count valores
+  void check_values(token_list const & toks, size_t count, std::string_view raw) {
+    if (toks.size() < count + 1) {
+      invalid_value(toks, raw);
     }
-    if (toks.size() > 2) {
-      throw std::runtime_error(
-          "Error: Extra data after configuration value for key: [image_width:]\nExtra: \"" +
-          join_from(toks, 2) +
-          "\"\nLine: \"" +
-          raw +
-          "\"");
+    if (toks.size() > count + 1) {
+      throw std::runtime_error(extra_data(toks, count + 1, raw));
     }
+  }
+
+  std::array<double, 3> parse_triplet(token_list const & toks) {
+    return {parse_double_strict(toks[1]), parse_double_strict(toks[2]),
+            parse_double_strict(toks[3])};
+  }
+
+  void parse_image_width(token_list const & toks, std::string_view raw, Config & cfg) {
+    check_values(toks, 1, raw);
     int w = parse_int_strict(toks[1]);
     if (w <= 0) {
-      throw std::runtime_error(
-          "Error: Invalid value for key: [image_width:]\nLine: \"" + raw + "\"");
+      invalid_value(toks, raw);
     }
     cfg.image_width = w;
   }
 
-  void parse_aspect_ratio(std::vector<std::string> const & toks, std::string const & raw,
-                          Config & cfg) {
-    if (toks.size() < 3) {
-      throw std::runtime_error(
-          "Error: Invalid value for key: [aspect_ratio:]\nLine: \"" + raw + "\"");
-    }
-    if (toks.size() > 3) {
-      throw std::runtime_error(
-          "Error: Extra data after configuration value for key: [aspect_ratio:]\nExtra: \"" +
-          join_from(toks, 3) +
-          "\"\nLine: \"" +
-          raw +
-          "\"");
-    }
+  void parse_aspect_ratio(token_list const & toks, std::string_view raw, Config & cfg) {
+    check_values(toks, 2, raw);
     int a = parse_int_strict(toks[1]);
     int b = parse_int_strict(toks[2]);
     if ((a <= 0) or (b <= 0)) {
-      throw std::runtime_error(
-          "Error: Invalid value for key: [aspect_ratio:]\nLine: \"" + raw + "\"");
+      invalid_value(toks, raw);
     }
     cfg.aspect_ratio = {a, b};
   }
 
-  void parse_gamma(std::vector<std::string> const & toks, std::string const & raw, Config & cfg) {
-    if (toks.size() < 2) {
-      throw std::runtime_error("Error: Invalid value for key: [gamma:]\nLine: \"" + raw + "\"");
-    }
-    if (toks.size() > 2) {
-      throw std::runtime_error(
-          "Error: Extra data after configuration value for key: [gamma:]\nExtra: \"" +
-          join_from(toks, 2) +
-          "\"\nLine: \"" +
-          raw +
-          "\"");
-    }
+  void parse_gamma(token_list const & toks, std::string_view raw, Config & cfg) {
+    check_values(toks, 1, raw);
     cfg.gamma = parse_double_strict(toks[1]);
   }
 
-  void parse_camera_position(std::vector<std::string> const & toks, std::string const & raw,
-                             Config & cfg) {
-    if (toks.size() < 4) {
-      throw std::runtime_error(
-          "Error: Invalid value for key: [camera_position:]\nLine: \"" + raw + "\"");
-    }
-    if (toks.size() > 4) {
-      throw std::runtime_error(
-          "Error: Extra data after configuration value for key: [camera_position:]\nExtra: \"" +
-          join_from(toks, 4) +
-          "\"\nLine: \"" +
-          raw +
-          "\"");
-    }
-    cfg.camera_position = {parse_double_strict(toks[1]), parse_double_strict(toks[2]),
-                           parse_double_strict(toks[3])};
-  }
-
-  void parse_camera_target(std::vector<std::string> const & toks, std::string const & raw,
-                           Config & cfg) {
-    if (toks.size() < 4) {
-      throw std::runtime_error(
-          "Error: Invalid value for key: [camera_target:]\nLine: \"" + raw + "\"");
-    }
-    if (toks.size() > 4) {
-      throw std::runtime_error(
-          "Error: Extra data after configuration value for key: [camera_target:]\nExtra: \"" +
-          join_from(toks, 4) +
-          "\"\nLine: \"" +
-          raw +
-          "\"");
-    }
-    cfg.camera_target = {parse_double_strict(toks[1]), parse_double_strict(toks[2]),
-                         parse_double_strict(toks[3])};
-  }
-
-  void parse_camera_north(std::vector<std::string> const & toks, std::string const & raw,
-                          Config & cfg) {
-    if (toks.size() < 4) {
-      throw std::runtime_error(
-          "Error: Invalid value for key: [camera_north:]\nLine: \"" + raw + "\"");
-    }
-    if (toks.size() > 4) {
-      throw std::runtime_error(
-          "Error: Extra data after configuration value for key: [camera_north:]\nExtra: \"" +
-          join_from(toks, 4) +
-          "\"\nLine: \"" +
-          raw +
-          "\"");
-    }
-    cfg.camera_north = {parse_double_strict(toks[1]), parse_double_strict(toks[2]),
-                        parse_double_strict(toks[3])};
-  }
-
-  void parse_field_of_view(std::vector<std::string> const & toks, std::string const & raw,
-                           Config & cfg) {
-    if (toks.size() < 2) {
-      throw std::runtime_error(
-          "Error: Invalid value for key: [field_of_view:]\nLine: \"" + raw + "\"");
-    }
-    if (toks.size() > 2) {
-      throw std::runtime_error(
-          "Error: Extra data after configuration value for key: [field_of_view:]\nExtra: \"" +
-          join_from(toks, 2) +
-          "\"\nLine: \"" +
-          raw +
-          "\"");
-    }
+  void parse_camera_position(token_list const & toks, std::string_view raw, Config & cfg) {
+    check_values(toks, 3, raw);
+    cfg.camera_position = parse_triplet(toks);
+  }
+
+  void parse_camera_target(token_list const & toks, std::string_view raw, Config & cfg) {
+    check_values(toks, 3, raw);
+    cfg.camera_target = parse_triplet(toks);
+  }
+
+  void parse_camera_north(token_list const & toks, std::string_view raw, Config & cfg) {
+    check_values(toks, 3, raw);
+    cfg.camera_north = parse_triplet(toks);
+  }
+
+  void parse_field_of_view(token_list const & toks, std::string_view raw, Config & cfg) {
+    check_values(toks, 1, raw);
     double f = parse_double_strict(toks[1]);
     if ((f <= 0.0) or (f >= 180.0)) {
-      throw std::runtime_error(
-          "Error: Invalid value for key: [field_of_view:]\nLine: \"" + raw + "\"");
+      invalid_value(toks, raw);
     }
     cfg.field_of_view = f;
   }
 
-  void parse_samples_per_pixel(std::vector<std::string> const & toks, std::string const & raw,
-                               Config & cfg) {
-    if (toks.size() < 2) {
-      throw std::runtime_error(
-          "Error: Invalid value for key: [samples_per_pixel:]\nLine: \"" + raw + "\"");
-    }
-    if (toks.size() > 2) {
-      throw std::runtime_error(
-          "Error: Extra data after configuration value for key: [samples_per_pixel:]\nExtra: \"" +
-          join_from(toks, 2) +
-          "\"\nLine: \"" +
-          raw +
-          "\"");
-    }
-    int s = parse_int_strict(toks[1]);
-    if (s <= 0) {
-      throw std::runtime_error(
-          "Error: Invalid value for key: [samples_per_pixel:]\nLine: \"" + raw + "\"");
+  // Entero estrictamente positivo (samples_per_pixel, max_depth, semillas y adaptive_round)
+  int parse_positive(token_list const & toks, std::string_view raw) {
+    check_values(toks, 1, raw);
+    int v = parse_int_strict(toks[1]);
+    if (v <= 0) {
+      invalid_value(toks, raw);
     }
-    cfg.samples_per_pixel = s;
+    return v;
   }
 
-  void parse_max_depth(std::vector<std::string> const & toks, std::string const & raw,
-                       Config & cfg) {
-    if (toks.size() < 2) {
-      throw std::runtime_error("Error: Invalid value for key: [max_depth:]\nLine: \"" + raw + "\"");
-    }
-    if (toks.size() > 2) {
-      throw std::runtime_error(
-          "Error: Extra data after configuration value for key: [max_depth:]\nExtra: \"" +
-          join_from(toks, 2) +
-          "\"\nLine: \"" +
-          raw +
-          "\"");
-    }
-    int m = parse_int_strict(toks[1]);
-    if (m <= 0) {
-      throw std::runtime_error("Error: Invalid value for key: [max_depth:]\nLine: \"" + raw + "\"");
+  // Color con componentes en [0, 1]
+  std::array<double, 3> parse_color(token_list const & toks, std::string_view raw) {
+    check_values(toks, 3, raw);
+    auto const c = parse_triplet(toks);
+    if (std::ranges::any_of(c, [](double v) { return (v < 0.0) or (v > 1.0); })) {
+      invalid_value(toks, raw);
     }
-    cfg.max_depth = m;
+    return c;
   }
 
-  void parse_material_rng_seed(std::vector<std::string> const & toks, std::string const & raw,
-                               Config & cfg) {
-    if (toks.size() < 2) {
-      throw std::runtime_error(
-          "Error: Invalid value for key: [material_rng_seed:]\nLine: \"" + raw + "\"");
-    }
-    if (toks.size() > 2) {
-      throw std::runtime_error(
-          "Error: Extra data after configuration value for key: [material_rng_seed:]\nExtra: \"" +
-          join_from(toks, 2) +
-          "\"\nLine: \"" +
-          raw +
-          "\"");
-    }
-    int v = parse_int_strict(toks[1]);
-    if (v <= 0) {
-      throw std::runtime_error(
-          "Error: Invalid value for key: [material_rng_seed:]\nLine: \"" + raw + "\"");
+  void parse_threads(token_list const & toks, std::string_view raw, Config & cfg) {
+    check_values(toks, 1, raw);
+    int n = parse_int_strict(toks[1]);
+    if (n < 0) {
+      invalid_value(toks, raw);
     }
-    cfg.material_rng_seed = v;
+    cfg.threads = n;
   }
 
-  void parse_ray_rng_seed(std::vector<std::string> const & toks, std::string const & raw,
-                          Config & cfg) {
-    if (toks.size() < 2) {
-      throw std::runtime_error(
-          "Error: Invalid value for key: [ray_rng_seed:]\nLine: \"" + raw + "\"");
+  void parse_adaptive_threshold(token_list const & toks, std::string_view raw, Config & cfg) {
+    check_values(toks, 1, raw);
+    double t = parse_double_strict(toks[1]);
+    if (not(t >= 0.0) or std::isinf(t)) {
+      invalid_value(toks, raw);
     }
-    if (toks.size() > 2) {
-      throw std::runtime_error(
-          "Error: Extra data after configuration value for key: [ray_rng_seed:]\nExtra: \"" +
-          join_from(toks, 2) +
-          "\"\nLine: \"" +
-          raw +
-          "\"");
-    }
-    int v = parse_int_strict(toks[1]);
-    if (v <= 0) {
-      throw std::runtime_error(
-          "Error: Invalid value for key: [ray_rng_seed:]\nLine: \"" + raw + "\"");
-    }
-    cfg.ray_rng_seed = v;
-  }
-
-  void parse_background_dark_color(std::vector<std::string> const & toks, std::string const & raw,
-                                   Config & cfg) {
-    if (toks.size() < 4) {
-      throw std::runtime_error(
-          "Error: Invalid value for key: [background_dark_color:]\nLine: \"" + raw + "\"");
-    }
-    if (toks.size() > 4) {
-      throw std::runtime_error("Error: Extra data after configuration value for key: "
-                               "[background_dark_color:]\nExtra: \"" +
-                               join_from(toks, 4) +
-                               "\"\nLine: \"" +
-                               raw +
-                               "\"");
-    }
-    double r = parse_double_strict(toks[1]);
-    double g = parse_double_strict(toks[2]);
-    double b = parse_double_strict(toks[3]);
-    if ((r < 0.0) or (r > 1.0) or (g < 0.0) or (g > 1.0) or (b < 0.0) or (b > 1.0)) {
-      throw std::runtime_error(
-          "Error: Invalid value for key: [background_dark_color:]\nLine: \"" + raw + "\"");
-    }
-    cfg.background_dark_color = {r, g, b};
-  }
-
-  void parse_background_light_color(std::vector<std::string> const & toks, std::string const & raw,
-                                    Config & cfg) {
-    if (toks.size() < 4) {
-      throw std::runtime_error(
-          "Error: Invalid value for key: [background_light_color:]\nLine: \"" + raw + "\"");
-    }
-    if (toks.size() > 4) {
-      throw std::runtime_error("Error: Extra data after configuration value for key: "
-                               "[background_light_color:]\nExtra: \"" +
-                               join_from(toks, 4) +
-                               "\"\nLine: \"" +
-                               raw +
-                               "\"");
-    }
-    double r = parse_double_strict(toks[1]);
-    double g = parse_double_strict(toks[2]);
-    double b = parse_double_strict(toks[3]);
-    if ((r < 0.0) or (r > 1.0) or (g < 0.0) or (g > 1.0) or (b < 0.0) or (b > 1.0)) {
-      throw std::runtime_error(
-          "Error: Invalid value for key: [background_light_color:]\nLine: \"" + raw + "\"");
-    }
-    cfg.background_light_color = {r, g, b};
-  }
-
-  void dispatch_config_key(std::vector<std::string> const & toks, std::string const & raw,
-                           Config & cfg) {
-    std::string const & key = toks[0];
+    cfg.adaptive_threshold = t;
+  }
+
+  void dispatch_config_key(token_list const & toks, std::string_view raw, Config & cfg) {
+    std::string_view const key = toks[0];
     if (key == "image_width:") {
       parse_image_width(toks, raw, cfg);
     } else if (key == "aspect_ratio:") {
@@ -365,19 +278,25 @@ namespace {
     } else if (key == "field_of_view:") {
       parse_field_of_view(toks, raw, cfg);
     } else if (key == "samples_per_pixel:") {
-      parse_samples_per_pixel(toks, raw, cfg);
+      cfg.samples_per_pixel = parse_positive(toks, raw);
     } else if (key == "max_depth:") {
-      parse_max_depth(toks, raw, cfg);
+      cfg.max_depth = parse_positive(toks, raw);
     } else if (key == "material_rng_seed:") {
-      parse_material_rng_seed(toks, raw, cfg);
+      cfg.material_rng_seed = parse_positive(toks, raw);
     } else if (key == "ray_rng_seed:") {
-      parse_ray_rng_seed(toks, raw, cfg);
+      cfg.ray_rng_seed = parse_positive(toks, raw);
     } else if (key == "background_dark_color:") {
-      parse_background_dark_color(toks, raw, cfg);
+      cfg.background_dark_color = parse_color(toks, raw);
     } else if (key == "background_light_color:") {
-      parse_background_light_color(toks, raw, cfg);
+      cfg.background_light_color = parse_color(toks, raw);
+    } else if (key == "threads:") {
+      parse_threads(toks, raw, cfg);
+    } else if (key == "adaptive_threshold:") {
+      parse_adaptive_threshold(toks, raw, cfg);
+    } else if (key == "adaptive_round:") {
+      cfg.adaptive_round = parse_positive(toks, raw);
     } else {
-      throw std::runtime_error(std::string("Error: Unknown configuration key: [") + key + "]");
+      throw std::runtime_error("Error: Unknown configuration key: [" + std::string(key) + "]");
     }
   }
 
@@ -385,232 +304,214 @@ namespace {
 
 Config parseConfig(std::string const & filename) {
   Config cfg;
-  std::ifstream ifs(filename);
-  if (!ifs) {
-    throw std::runtime_error("No se pudo abrir archivo: " + filename);
-  }
+  render::mapped_file const file(filename);
 
-  std::string raw;
-  while (std::getline(ifs, raw)) {
-    if (is_blank(raw)) {
-      continue;
-    }
-    std::string line = trim(raw);
-    auto toks        = split_ws(line);
-    if (toks.empty()) {
-      continue;
+  token_list toks;
+  for_each_line(file.view(), [&](std::string_view raw) {
+    split_ws(raw, toks);
+    if (not toks.empty()) {
+      dispatch_config_key(toks, raw, cfg);
     }
-    dispatch_config_key(toks, raw, cfg);
-  }
+  });
 
   return cfg;
 }
 
+void parseConfigLine(std::string_view line, Config & cfg) {
+  token_list toks;
+  split_ws(line, toks);
+  if (not toks.empty()) {
+    dispatch_config_key(toks, line, cfg);
+  }
+}
+
 // --- parseScene ---
+//
+// El fichero se divide en trozos alineados a líneas que se analizan en paralelo. Cada trozo
+// guarda sus materiales y objetos con el nombre del material sin resolver y se detiene en su
+// primer error. Después los materiales se registran en orden de fichero (duplicados incluidos)
+// y los objetos se resuelven en paralelo: un objeto solo ve los materiales definidos antes que
+// él. Todos los errores llevan la posición de su línea y se lanza el primero, que es el mismo
+// que encontraría una lectura secuencial.
 namespace {
 
-  int find_material(std::vector<Material> const & materials, std::string const & name) {
-    for (size_t i = 0; i < materials.size(); ++i) {
-      if (materials[i].name == name) {
-        return static_cast<int>(i);
+  // Tamaño fijo, sin huecos de relleno: una escena de un millón de objetos ocupa 72 MB
+  static_assert(sizeof(Object) == 72);
+
+  // Tamaño mínimo de trozo: por debajo no compensa repartir el trabajo
+  constexpr std::size_t min_chunk_bytes = std::size_t{1} << 20U;
+
+  // Primer error (en orden de fichero) de entre los encontrados
+  struct first_error {
+    std::uint64_t offset = UINT64_MAX;
+    std::exception_ptr error;
+
+    void keep(std::uint64_t at, std::exception_ptr e) {
+      if (at < offset) {
+        offset = at;
+        error  = std::move(e);
       }
     }
-    return -1;
+  };
+
+  // Material leído por un trozo. El error de valores se aplaza: la comprobación de nombre
+  // duplicado va antes y depende de los trozos anteriores.
+  struct material_entry {
+    std::uint64_t offset;
+    std::string_view name;
+    Material material;
+    std::exception_ptr error;
+  };
+
+  struct scene_chunk {
+    std::string_view text;
+    std::uint64_t base = 0;  // posición del trozo en el fichero
+    std::vector<material_entry> materials;
+    std::vector<Object> objects;
+    std::vector<std::string_view> object_materials;  // nombre sin resolver de cada objeto
+    first_error error;
+  };
+
+  // Materiales con un índice hash por nombre. Las claves apuntan al fichero proyectado, que
+  // sigue vivo durante todo el parsing, así que no copian el nombre.
+  struct material_table {
+    struct slot {
+      std::uint32_t index;
+      std::uint64_t offset;  // línea de la definición
+    };
+
+    std::vector<Material> materials;
+    std::unordered_map<std::string_view, slot> index;
+  };
+
+  // La entidad debe tener exactamente count tokens; invalid es el mensaje si faltan
+  void check_tokens(token_list const & toks, size_t count, char const * invalid,
+                    std::string_view raw) {
+    if (toks.size() < count) {
+      throw std::runtime_error(invalid + line_info(raw));
+    }
+    if (toks.size() > count) {
+      throw std::runtime_error(extra_data(toks, count, raw));
+    }
+  }
+
+  std::exception_ptr material_exists_error(std::string_view name, std::string_view raw) {
+    std::string msg = "Error: Material with name [";
+    msg += name;
+    msg += "] already exists";
+    msg += line_info(raw);
+    return std::make_exception_ptr(std::runtime_error(msg));
+  }
+
+  std::exception_ptr material_not_found_error(std::string_view mat, std::string_view raw) {
+    std::string msg = "Error: Material not found: [";
+    msg += mat;
+    msg += "]";
+    msg += line_info(raw);
+    return std::make_exception_ptr(std::runtime_error(msg));
+  }
+
+  // Línea completa que empieza en offset
+  std::string_view line_at(std::string_view text, std::uint64_t offset) {
+    std::string_view const rest = text.substr(offset);
+    return rest.substr(0, rest.find('\n'));
+  }
+
+  template <typename Values>
+  void add_material(token_list const & toks, std::string_view raw, std::uint64_t offset,
+                    MaterialType type, char const * invalid, Values && values,
+                    scene_chunk & chunk) {
+    material_entry entry{offset, toks[1], {std::string(toks[1]), type, {}}, nullptr};
+    try {
+      entry.material.params = values();
+    } catch (...) {
+      entry.error = std::make_exception_ptr(std::runtime_error(invalid + line_info(raw)));
+    }
+    chunk.materials.push_back(std::move(entry));
   }
 
-  void parse_matte(std::vector<std::string> const & toks, std::string const & raw,
-                   std::vector<Material> & materials) {
-    if (toks.size() < 5) {
-      throw std::runtime_error("Error: Invalid matte material parameters\nLine: \"" + raw + "\"");
-    }
-    if (toks.size() > 5) {
-      throw std::runtime_error(
-          "Error: Extra data after configuration value for key: [matte:]\nExtra: \"" +
-          join_from(toks, 5) +
-          "\"\nLine: \"" +
-          raw +
-          "\"");
-    }
-    std::string name = toks[1];
-    if (find_material(materials, name) != -1) {
-      std::string msg = "Error: Material with name [";
-      msg += name;
-      msg += "] already exists\nLine: \"";
-      msg += raw;
-      msg += "\"";
-      throw std::runtime_error(msg);
-    }
-    try {
+  void parse_matte(token_list const & toks, std::string_view raw, std::uint64_t offset,
+                   scene_chunk & chunk) {
+    constexpr char const * invalid = "Error: Invalid matte material parameters";
+    check_tokens(toks, 5, invalid, raw);
+    add_material(toks, raw, offset, MaterialType::Matte, invalid, [&] {
       double r = parse_double_strict(toks[2]);
       double g = parse_double_strict(toks[3]);
       double b = parse_double_strict(toks[4]);
       if ((r < 0.0) or (r > 1.0) or (g < 0.0) or (g > 1.0) or (b < 0.0) or (b > 1.0)) {
         throw std::invalid_argument("range");
       }
-      materials.push_back({
-        name, MaterialType::Matte, {r, g, b}
-      });
-    } catch (...) {
-      throw std::runtime_error("Error: Invalid matte material parameters\nLine: \"" + raw + "\"");
-    }
+      return std::array<double, 4>{r, g, b, 0.0};
+    }, chunk);
   }
 
-  void parse_metal(std::vector<std::string> const & toks, std::string const & raw,
-                   std::vector<Material> & materials) {
-    if (toks.size() < 6) {
-      throw std::runtime_error("Error: Invalid metal material parameters\nLine: \"" + raw + "\"");
-    }
-    if (toks.size() > 6) {
-      throw std::runtime_error(
-          "Error: Extra data after configuration value for key: [metal:]\nExtra: \"" +
-          join_from(toks, 6) +
-          "\"\nLine: \"" +
-          raw +
-          "\"");
-    }
-    std::string name = toks[1];
-    if (find_material(materials, name) != -1) {
-      std::string msg = "Error: Material with name [";
-      msg += name;
-      msg += "] already exists\nLine: \"";
-      msg += raw;
-      msg += "\"";
-      throw std::runtime_error(msg);
-    }
-    try {
+  void parse_metal(token_list const & toks, std::string_view raw, std::uint64_t offset,
+                   scene_chunk & chunk) {
+    constexpr char const * invalid = "Error: Invalid metal material parameters";
+    check_tokens(toks, 6, invalid, raw);
+    add_material(toks, raw, offset, MaterialType::Metal, invalid, [&] {
       double r   = parse_double_strict(toks[2]);
       double g   = parse_double_strict(toks[3]);
       double b   = parse_double_strict(toks[4]);
       double phi = parse_double_strict(toks[5]);
-      materials.push_back({
-        name, MaterialType::Metal, {r, g, b, phi}
-      });
-    } catch (...) {
-      throw std::runtime_error("Error: Invalid metal material parameters\nLine: \"" + raw + "\"");
-    }
+      return std::array<double, 4>{r, g, b, phi};
+    }, chunk);
   }
 
-  void parse_refractive(std::vector<std::string> const & toks, std::string const & raw,
-                        std::vector<Material> & materials) {
-    if (toks.size() < 3) {
-      throw std::runtime_error(
-          "Error: Invalid refractive material parameters\nLine: \"" + raw + "\"");
-    }
-    if (toks.size() > 3) {
-      throw std::runtime_error(
-          "Error: Extra data after configuration value for key: [refractive:]\nExtra: \"" +
-          join_from(toks, 3) +
-          "\"\nLine: \"" +
-          raw +
-          "\"");
-    }
-    std::string name = toks[1];
-    if (find_material(materials, name) != -1) {
-      std::string msg = "Error: Material with name [";
-      msg += name;
-      msg += "] already exists\nLine: \"";
-      msg += raw;
-      msg += "\"";
-      throw std::runtime_error(msg);
-    }
-    try {
+  void parse_refractive(token_list const & toks, std::string_view raw, std::uint64_t offset,
+                        scene_chunk & chunk) {
+    constexpr char const * invalid = "Error: Invalid refractive material parameters";
+    check_tokens(toks, 3, invalid, raw);
+    add_material(toks, raw, offset, MaterialType::Refractive, invalid, [&] {
       double rho = parse_double_strict(toks[2]);
-      materials.push_back({name, MaterialType::Refractive, {rho}});
-    } catch (...) {
-      throw std::runtime_error(
-          "Error: Invalid refractive material parameters\nLine: \"" + raw + "\"");
-    }
+      return std::array<double, 4>{rho, 0.0, 0.0, 0.0};
+    }, chunk);
   }
 
-  void parse_sphere(std::vector<std::string> const & toks, std::string const & raw,
-                    std::vector<Material> & materials, std::vector<Object> & objects) {
-    if (toks.size() < 6) {
-      throw std::runtime_error("Error: Invalid sphere parameters\nLine: \"" + raw + "\"");
-    }
-    if (toks.size() > 6) {
-      throw std::runtime_error(
-          "Error: Extra data after configuration value for key: [sphere:]\nExtra: \"" +
-          join_from(toks, 6) +
-          "\"\nLine: \"" +
-          raw +
-          "\"");
-    }
+  void parse_sphere(token_list const & toks, std::string_view raw, std::uint64_t offset,
+                    scene_chunk & chunk) {
+    constexpr char const * invalid = "Error: Invalid sphere parameters";
+    check_tokens(toks, 6, invalid, raw);
     try {
-      double cx       = parse_double_strict(toks[1]);
-      double cy       = parse_double_strict(toks[2]);
-      double cz       = parse_double_strict(toks[3]);
-      double r        = parse_double_strict(toks[4]);
-      std::string mat = toks[5];
+      double cx = parse_double_strict(toks[1]);
+      double cy = parse_double_strict(toks[2]);
+      double cz = parse_double_strict(toks[3]);
+      double r  = parse_double_strict(toks[4]);
       if (r <= 0.0) {
         throw std::invalid_argument("radius");
       }
-      if (find_material(materials, mat) == -1) {
-        std::string msg = "Error: Material not found: [";
-        msg += mat;
-        msg += "]\nLine: \"";
-        msg += raw;
-        msg += "\"";
-        throw std::runtime_error(msg);
-      }
-      objects.push_back({
-        ObjectType::Sphere, {cx, cy, cz, r},
-         mat, raw
+      chunk.objects.push_back({
+        ObjectType::Sphere, 0, {cx, cy, cz, r, 0.0, 0.0, 0.0},
+         offset
       });
-    } catch (std::runtime_error const & e) {
-      throw;
+      chunk.object_materials.push_back(toks[5]);
     } catch (...) {
-      throw std::runtime_error("Error: Invalid sphere parameters\nLine: \"" + raw + "\"");
-    }
-  }
-
-  int get_material_index_or_throw(std::vector<Material> const & materials, std::string const & mat,
-                                  std::string const & raw) {
-    int idx = find_material(materials, mat);
-    if (idx == -1) {
-      std::string msg = "Error: Material not found: [";
-      msg += mat;
-      msg += "]\nLine: \"";
-      msg += raw;
-      msg += "\"";
-      throw std::runtime_error(msg);
+      throw std::runtime_error(invalid + line_info(raw));
     }
-    return idx;
   }
 
-  void parse_cylinder(std::vector<std::string> const & toks, std::string const & raw,
-                      std::vector<Material> & materials, std::vector<Object> & objects) {
-    if (toks.size() < 9) {
-      throw std::runtime_error("Error: Invalid cylinder parameters\nLine: \"" + raw + "\"");
-    }
-    if (toks.size() > 9) {
-      throw std::runtime_error(
-          "Error: Extra data after configuration value for key: [cylinder:]\nExtra: \"" +
-          join_from(toks, 9) +
-          "\"\nLine: \"" +
-          raw +
-          "\"");
-    }
+  void parse_cylinder(token_list const & toks, std::string_view raw, std::uint64_t offset,
+                      scene_chunk & chunk) {
+    constexpr char const * invalid = "Error: Invalid cylinder parameters";
+    check_tokens(toks, 9, invalid, raw);
     try {
-      double cx       = parse_double_strict(toks[1]);
-      double cy       = parse_double_strict(toks[2]);
-      double cz       = parse_double_strict(toks[3]);
-      double r        = parse_double_strict(toks[4]);
-      double ax       = parse_double_strict(toks[5]);
-      double ay       = parse_double_strict(toks[6]);
-      double az       = parse_double_strict(toks[7]);
-      std::string mat = toks[8];
+      double cx = parse_double_strict(toks[1]);
+      double cy = parse_double_strict(toks[2]);
+      double cz = parse_double_strict(toks[3]);
+      double r  = parse_double_strict(toks[4]);
+      double ax = parse_double_strict(toks[5]);
+      double ay = parse_double_strict(toks[6]);
+      double az = parse_double_strict(toks[7]);
       if (r <= 0.0) {
         throw std::invalid_argument("radius");
       }
-      get_material_index_or_throw(materials, mat, raw);
-      objects.push_back({
-        ObjectType::Cylinder, {cx, cy, cz, r, ax, ay, az},
-         mat, raw
+      chunk.objects.push_back({
+        ObjectType::Cylinder, 0, {cx, cy, cz, r, ax, ay, az},
+         offset
       });
-    } catch (std::runtime_error const & e) {
-      throw;
+      chunk.object_materials.push_back(toks[8]);
     } catch (...) {
-      throw std::runtime_error("Error: Invalid cylinder parameters\nLine: \"" + raw + "\"");
+      throw std::runtime_error(invalid + line_info(raw));
     }
   }
 
@@ -618,52 +519,180 @@ namespace {
 
 namespace {
 
-  void dispatch_scene_entity(std::vector<std::string> const & toks, std::string const & raw,
-                             std::vector<Material> & materials, std::vector<Object> & objects) {
-    std::string const & key = toks[0];
+  void dispatch_scene_entity(token_list const & toks, std::string_view raw,
+                             std::uint64_t offset, scene_chunk & chunk) {
+    std::string_view const key = toks[0];
     if (key == "matte:") {
-      parse_matte(toks, raw, materials);
+      parse_matte(toks, raw, offset, chunk);
     } else if (key == "metal:") {
-      parse_metal(toks, raw, materials);
+      parse_metal(toks, raw, offset, chunk);
     } else if (key == "refractive:") {
-      parse_refractive(toks, raw, materials);
+      parse_refractive(toks, raw, offset, chunk);
     } else if (key == "sphere:") {
-      parse_sphere(toks, raw, materials, objects);
+      parse_sphere(toks, raw, offset, chunk);
     } else if (key == "cylinder:") {
-      parse_cylinder(toks, raw, materials, objects);
+      parse_cylinder(toks, raw, offset, chunk);
     } else {
       // unknown entity: strip trailing ':' if present for nicer message
-      std::string ent = key;
-      if (!ent.empty() and ent.back() == ':') {
-        ent.pop_back();
+      std::string_view ent = key;
+      if (ent.ends_with(':')) {
+        ent.remove_suffix(1);
       }
-      throw std::runtime_error(std::string("Error: Unknown scene entity: ") + ent);
+      throw std::runtime_error("Error: Unknown scene entity: " + std::string(ent));
     }
   }
 
-}  // namespace
+  // Trozos de al menos min_chunk_bytes que empiezan siempre al principio de una línea
+  std::vector<scene_chunk> split_chunks(std::string_view text, std::size_t count) {
+    std::size_t const target = std::max(min_chunk_bytes, text.size() / count);
+    std::vector<scene_chunk> chunks;
+    std::size_t begin = 0;
+    while (begin < text.size()) {
+      std::size_t end = std::min(text.size(), begin + target);
+      if (end < text.size()) {
+        std::size_t const nl = text.find('\n', end);
+        end                  = (nl == std::string_view::npos) ? text.size() : nl + 1;
+      }
+      scene_chunk chunk;
+      chunk.text = text.substr(begin, end - begin);
+      chunk.base = begin;
+      chunks.push_back(std::move(chunk));
+      begin = end;
+    }
+    return chunks;
+  }
 
-std::pair<std::vector<Material>, std::vector<Object>> parseScene(std::string const & filename) {
-  std::ifstream ifs(filename);
-  if (!ifs) {
-    throw std::runtime_error("No se pudo abrir archivo: " + filename);
+  void parse_chunk(scene_chunk & chunk) {
+    // Cota superior del número de objetos: evita las copias al crecer el vector
+    auto const lines = static_cast<std::size_t>(std::ranges::count(chunk.text, '\n')) + 1;
+    chunk.objects.reserve(lines);
+    chunk.object_materials.reserve(lines);
+
+    token_list toks;
+    try {
+      for_each_line(chunk.text, [&](std::string_view raw) {
+        split_ws(raw, toks);
+        if (not toks.empty()) {
+          auto const offset =
+              chunk.base + static_cast<std::uint64_t>(raw.data() - chunk.text.data());
+          try {
+            dispatch_scene_entity(toks, raw, offset, chunk);
+          } catch (...) {
+            chunk.error.keep(offset, std::current_exception());
+            throw;
+          }
+        }
+      });
+    } catch (...) {
+      // El trozo se detiene en su primer error; el resto no puede cambiar el resultado
+    }
+  }
+
+  // Registra los materiales en orden de fichero hasta el primer error, sin pasar de los errores
+  // ya encontrados por los trozos
+  material_table register_materials(std::vector<scene_chunk> const & chunks,
+                                    std::string_view text, first_error & error) {
+    material_table table;
+    for (auto const & chunk : chunks) {
+      for (auto const & entry : chunk.materials) {
+        if (entry.offset > error.offset) {
+          return table;
+        }
+        if (table.index.contains(entry.name)) {
+          error.keep(entry.offset, material_exists_error(entry.name, line_at(text, entry.offset)));
+          return table;
+        }
+        if (entry.error) {
+          error.keep(entry.offset, entry.error);
+          return table;
+        }
+        table.index.emplace(
+            entry.name,
+            material_table::slot{static_cast<std::uint32_t>(table.materials.size()), entry.offset});
+        table.materials.push_back(entry.material);
+      }
+    }
+    return table;
   }
 
-  std::vector<Material> materials;
-  std::vector<Object> objects;
+  // Resuelve los materiales de un trozo y copia sus objetos a partir de out
+  void resolve_objects(scene_chunk & chunk, material_table const & table, std::string_view text,
+                       Object * out) {
+    for (std::size_t i = 0; i < chunk.objects.size(); ++i) {
+      Object obj                 = chunk.objects[i];
+      std::string_view const mat = chunk.object_materials[i];
+      auto const it              = table.index.find(mat);
+      if ((it == table.index.end()) or (it->second.offset > obj.line_offset)) {
+        chunk.error.keep(obj.line_offset,
+                         material_not_found_error(mat, line_at(text, obj.line_offset)));
+        return;
+      }
+      obj.material_index = it->second.index;
+      out[i]             = obj;
+    }
+  }
+
+  std::pair<std::vector<Material>, std::vector<Object>>
+      parse_scene_text(std::string_view text, render::work_stealing_pool * pool) {
+    std::size_t const workers = (pool != nullptr) ? pool->size() : 1;
+    // Varios trozos por hilo para que el robo de trabajo equilibre la carga
+    std::vector<scene_chunk> chunks = split_chunks(text, 4 * workers);
+    auto const for_each_chunk       = [&](std::function<void(std::size_t)> const & task) {
+      if ((pool != nullptr) and (chunks.size() > 1)) {
+        pool->run(chunks.size(), task);
+      } else {
+        for (std::size_t c = 0; c < chunks.size(); ++c) {
+          task(c);
+        }
+      }
+    };
+
+    for_each_chunk([&](std::size_t c) { parse_chunk(chunks[c]); });
 
-  std::string raw;
-  while (std::getline(ifs, raw)) {
-    if (is_blank(raw)) {
-      continue;
+    first_error error;
+    std::vector<std::size_t> first(chunks.size());
+    std::size_t total = 0;
+    for (std::size_t c = 0; c < chunks.size(); ++c) {
+      error.keep(chunks[c].error.offset, chunks[c].error.error);
+      first[c]  = total;
+      total    += chunks[c].objects.size();
     }
-    std::string line = trim(raw);
-    auto toks        = split_ws(line);
-    if (toks.empty()) {
-      continue;
+    material_table table = register_materials(chunks, text, error);
+
+    std::vector<Object> objects(total);
+    for_each_chunk([&](std::size_t c) {
+      resolve_objects(chunks[c], table, text, objects.data() + first[c]);
+      chunks[c].objects          = {};
+      chunks[c].object_materials = {};
+    });
+
+    for (auto const & chunk : chunks) {
+      error.keep(chunk.error.offset, chunk.error.error);
     }
-    dispatch_scene_entity(toks, raw, materials, objects);
+    if (error.error) {
+      std::rethrow_exception(error.error);
+    }
+    return {std::move(table.materials), std::move(objects)};
   }
 
-  return {materials, objects};
+}  // namespace
+
+std::pair<std::vector<Material>, std::vector<Object>> parseScene(std::string const & filename) {
+  render::mapped_file const file(filename);
+  return parse_scene_text(file.view(), nullptr);
+}
+
+std::pair<std::vector<Material>, std::vector<Object>>
+    parseScene(std::string const & filename, render::work_stealing_pool & pool) {
+  render::mapped_file const file(filename);
+  return parse_scene_text(file.view(), &pool);
+}
+
+std::string readObjectLine(std::string const & filename, Object const & obj) {
+  render::mapped_file const file(filename);
+  std::string_view const text = file.view();
+  if (obj.line_offset >= text.size()) {
+    throw std::runtime_error("Error: Object line out of range in file: " + filename);
+  }
+  return std::string(line_at(text, obj.line_offset));
 }
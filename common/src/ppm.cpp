@@ -0,0 +1,103 @@
+#include "ppm.hpp"
+
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <stdexcept>
+
+namespace render {
+
+  namespace {
+
+    // Tamaño a partir del cual el búfer se vuelca al flujo
+    constexpr std::size_t flush_threshold = std::size_t{1} << 20U;
+
+    // Texto decimal de cada componente 0..255, precalculado
+    struct decimal {
+      std::array<char, 3> text;
+      std::size_t size;
+    };
+
+    constexpr std::array<decimal, 256> make_decimals() {
+      std::array<decimal, 256> table{};
+      for (std::size_t v = 0; v < table.size(); ++v) {
+        auto & d = table[v];
+        if (v >= 100) {
+          d.text[d.size++] = static_cast<char>('0' + v / 100);
+        }
+        if (v >= 10) {
+          d.text[d.size++] = static_cast<char>('0' + v / 10 % 10);
+        }
+        d.text[d.size++] = static_cast<char>('0' + v % 10);
+      }
+      return table;
+    }
+
+    constexpr std::array<decimal, 256> decimals = make_decimals();
+
+    // Sin relleno: una secuencia de rgb8 es ya el contenido binario de un P6
+    static_assert(sizeof(rgb8) == 3);
+
+    void append_p3(std::string & buffer, rgb8 const & p) {
+      for (std::size_t k = 0; k < 3; ++k) {
+        decimal const & d = decimals[p[k]];
+        buffer.append(d.text.data(), d.size);
+        buffer.push_back((k < 2) ? ' ' : '\n');
+      }
+    }
+
+  }  // namespace
+
+  ppm_format parse_ppm_format(std::string const & name) {
+    if (name == "p3") {
+      return ppm_format::p3;
+    }
+    if (name == "p6") {
+      return ppm_format::p6;
+    }
+    throw std::runtime_error("Error: Invalid output format: [" + name + "]");
+  }
+
+  ppm_writer::ppm_writer(std::ostream & out, int width, int height, ppm_format format)
+      : out{out}, format{format} {
+    buffer.reserve(flush_threshold + 16);  // margen para el último píxel añadido
+    buffer += (format == ppm_format::p3) ? "P3\n" : "P6\n";
+    buffer += std::to_string(height) + " " + std::to_string(width) + "\n255\n";
+  }
+
+  void ppm_writer::write(std::span<rgb8 const> pixels) {
+    if (format == ppm_format::p6) {
+      // Se copian los bytes en bloques que llenan el búfer hasta el umbral de volcado
+      auto const bytes = std::as_bytes(pixels);
+      for (std::size_t done = 0; done < bytes.size();) {
+        std::size_t const n = std::min(bytes.size() - done, flush_threshold - buffer.size());
+        buffer.append(reinterpret_cast<char const *>(bytes.data() + done), n);
+        done += n;
+        if (buffer.size() >= flush_threshold) {
+          flush();
+        }
+      }
+      return;
+    }
+    for (auto const & p : pixels) {
+      append_p3(buffer, p);
+      if (buffer.size() >= flush_threshold) {
+        flush();
+      }
+    }
+  }
+
+  void ppm_writer::finish() {
+    flush();
+    out.flush();
+    if (not out) {
+      throw std::runtime_error("Error: Could not write output file");
+    }
+  }
+
+  void ppm_writer::flush() {
+    out.write(buffer.data(), static_cast<std::streamsize>(buffer.size()));
+    buffer.clear();
+  }
+
+}  // namespace render
@@ -0,0 +1,187 @@
+#include "progressive.hpp"
+
+#include "checksum.hpp"
+#include "color.hpp"
+#include "mapped_file.hpp"
+#include "stats.hpp"
+
+#include <array>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <stdexcept>
+#include <string_view>
+#include <utility>
+
+namespace render {
+
+  namespace {
+
+    constexpr std::array<char, 8> magic = {'\x89', 'R', 'C', 'K', 'P', '\r', '\n', '\x1a'};
+
+    constexpr std::uint32_t byte_order_mark = 0x01020304;
+
+    struct checkpoint_header {
+      std::array<char, 8> signature;
+      std::uint32_t version;
+      std::uint32_t byte_order;
+      std::int32_t width;
+      std::int32_t height;
+      std::int32_t pass_samples;
+      std::int32_t passes_done;
+      std::uint64_t fingerprint;
+      std::uint64_t checksum;  // de los píxeles
+      std::uint64_t pixel_count;
+    };
+
+    std::string_view pixel_bytes(std::vector<pixel_estimate> const & pixels) {
+      return {reinterpret_cast<char const *>(pixels.data()),
+              pixels.size() * sizeof(pixel_estimate)};
+    }
+
+    // Escribe bytes en path a través de un fichero temporal que después se renombra
+    template <typename Write>
+    bool replace_file(std::string const & path, Write const & write) {
+      std::string const temp = path + ".tmp";
+      {
+        std::ofstream out(temp, std::ios::binary);
+        if (not out) {
+          return false;
+        }
+        write(out);
+        out.flush();
+        if (not out) {
+          return false;
+        }
+      }
+      std::error_code ec;
+      std::filesystem::rename(temp, path, ec);
+      return not ec;
+    }
+
+    void write_preview(progressive_job const & job, progress_state const & state,
+                       tone_mapper const & mapper) {
+      bool const ok = replace_file(job.output, [&](std::ostream & out) {
+        ppm_writer writer(out, state.width, state.height, job.format);
+        writer.write(state.image().pack(mapper));
+        writer.finish();
+      });
+      if (not ok) {
+        throw std::runtime_error("Error: Could not write output file: [" + job.output + "]");
+      }
+    }
+
+  }  // namespace
+
+  progress_state::progress_state(int width, int height, int pass_samples,
+                                 std::uint64_t fingerprint)
+      : width{width}, height{height}, pass_samples{pass_samples}, fingerprint{fingerprint},
+        pixels(static_cast<std::size_t>(width) * static_cast<std::size_t>(height)) {}
+
+  int progress_state::pass_count(Config const & cfg) const {
+    return (cfg.samples_per_pixel + pass_samples - 1) / pass_samples;
+  }
+
+  framebuffer progress_state::image() const {
+    framebuffer out(width, height);
+    for (std::size_t i = 0; i < pixels.size(); ++i) {
+      if (pixels[i].get_count() > 0) {
+        out.set(i, pixels[i].mean());
+      }
+    }
+    return out;
+  }
+
+  std::uint64_t input_fingerprint(std::span<std::string const> paths) {
+    std::string hashes;
+    for (auto const & path : paths) {
+      mapped_file const file(path);
+      std::uint64_t const h = checksum(file.view());
+      hashes.append(reinterpret_cast<char const *>(&h), sizeof(h));
+    }
+    return checksum(hashes);
+  }
+
+  void write_checkpoint(std::string const & path, progress_state const & state) {
+    std::string_view const data = pixel_bytes(state.pixels);
+    checkpoint_header const header{magic,
+                                   checkpoint_version,
+                                   byte_order_mark,
+                                   state.width,
+                                   state.height,
+                                   state.pass_samples,
+                                   state.passes_done,
+                                   state.fingerprint,
+                                   checksum(data),
+                                   state.pixels.size()};
+    bool const ok = replace_file(path, [&](std::ostream & out) {
+      out.write(reinterpret_cast<char const *>(&header), sizeof(header));
+      out.write(data.data(), static_cast<std::streamsize>(data.size()));
+    });
+    if (not ok) {
+      throw std::runtime_error("Error: Could not write checkpoint: [" + path + "]");
+    }
+  }
+
+  std::optional<progress_state> read_checkpoint(std::string const & path,
+                                                progress_state const & expected) {
+    if (not std::filesystem::exists(path)) {
+      return std::nullopt;
+    }
+    mapped_file const file(path);
+    std::string_view const bytes = file.view();
+    std::runtime_error const corrupt("Error: Corrupt checkpoint: [" + path + "]");
+    checkpoint_header header{};
+    if (bytes.size() < sizeof(header)) {
+      throw corrupt;
+    }
+    std::memcpy(&header, bytes.data(), sizeof(header));
+    if ((header.signature != magic) or (header.byte_order != byte_order_mark)) {
+      throw corrupt;
+    }
+    if (header.version != checkpoint_version) {
+      throw std::runtime_error("Error: Unsupported checkpoint version: [" + path + "]");
+    }
+    if ((header.width != expected.width) or (header.height != expected.height) or
+        (header.pass_samples != expected.pass_samples) or
+        (header.fingerprint != expected.fingerprint) or
+        (header.pixel_count != expected.pixels.size())) {
+      throw std::runtime_error("Error: Checkpoint does not match this render: [" + path + "]");
+    }
+    std::string_view const data = bytes.substr(sizeof(header));
+    if ((data.size() != header.pixel_count * sizeof(pixel_estimate)) or
+        (header.checksum != checksum(data)) or (header.passes_done < 0)) {
+      throw corrupt;
+    }
+
+    progress_state state(expected.width, expected.height, expected.pass_samples,
+                         expected.fingerprint);
+    state.passes_done = header.passes_done;
+    std::memcpy(state.pixels.data(), data.data(), data.size());
+    return state;
+  }
+
+  void run_progressive(Config const & cfg, progressive_job const & job, progress_state & state,
+                       std::function<void(progress_state &)> const & render_pass,
+                       std::ostream & log) {
+    tone_mapper const mapper(cfg.gamma);
+    int const passes = state.pass_count(cfg);
+    if (auto resumed = read_checkpoint(job.checkpoint, state)) {
+      state = std::move(*resumed);
+      log << "Resuming " << job.checkpoint << " (" << state.passes_done << "/" << passes
+          << " passes)\n";
+      write_preview(job, state, mapper);
+    }
+
+    stopwatch last_save;
+    while (state.passes_done < passes) {
+      render_pass(state);
+      if ((state.passes_done == passes) or (last_save.seconds() >= job.interval)) {
+        write_checkpoint(job.checkpoint, state);
+        write_preview(job, state, mapper);
+        last_save = stopwatch{};
+      }
+    }
+  }
+
+}  // namespace render
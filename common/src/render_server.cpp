@@ -0,0 +1,225 @@
+#include "render_server.hpp"
+#include "checksum.hpp"
+#include "mapped_file.hpp"
+#include "stats.hpp"
+
+#include <array>
+#include <cerrno>
+#include <cstring>
+#include <exception>
+#include <stdexcept>
+#include <streambuf>
+#include <sys/socket.h>
+#include <sys/stat.h>
+#include <sys/un.h>
+#include <unistd.h>
+#include <utility>
+#include <vector>
+
+namespace render {
+
+  namespace {
+
+    // Las peticiones son una línea corta; una más larga se rechaza sin esperar al final
+    constexpr std::size_t max_request = 4'096;
+
+    bool is_blank(char c) { return (c == ' ') or (c == '\t') or (c == '\r'); }
+
+    // Descriptor que se cierra al salir de ámbito
+    class unique_fd {
+    public:
+      explicit unique_fd(int descriptor) : fd{descriptor} {}
+
+      ~unique_fd() {
+        if (fd >= 0) {
+          ::close(fd);
+        }
+      }
+
+      unique_fd(unique_fd && other) noexcept : fd{std::exchange(other.fd, -1)} {}
+
+      unique_fd(unique_fd const &)             = delete;
+      unique_fd & operator=(unique_fd const &) = delete;
+
+      [[nodiscard]] int get() const { return fd; }
+
+    private:
+      int fd;
+    };
+
+    // Flujo de salida sobre un socket. Con MSG_NOSIGNAL un cliente que se desconecta solo
+    // deja el flujo en error, sin SIGPIPE.
+    class socket_buf : public std::streambuf {
+    public:
+      explicit socket_buf(int descriptor) : fd{descriptor}, buffer(1 << 16) {
+        setp(buffer.data(), buffer.data() + buffer.size());
+      }
+
+      // Bytes ya enviados al cliente
+      [[nodiscard]] std::size_t sent() const { return sent_bytes; }
+
+      // Descarta lo que aún no se ha enviado
+      void discard() { setp(buffer.data(), buffer.data() + buffer.size()); }
+
+    protected:
+      int_type overflow(int_type ch) override {
+        if (not flush_buffer()) {
+          return traits_type::eof();
+        }
+        if (not traits_type::eq_int_type(ch, traits_type::eof())) {
+          *pptr() = traits_type::to_char_type(ch);
+          pbump(1);
+        }
+        return traits_type::not_eof(ch);
+      }
+
+      int sync() override { return flush_buffer() ? 0 : -1; }
+
+    private:
+      bool flush_buffer() {
+        char const * p = pbase();
+        while (p < pptr()) {
+          auto const n = ::send(fd, p, static_cast<std::size_t>(pptr() - p), MSG_NOSIGNAL);
+          if (n < 0) {
+            if (errno == EINTR) {
+              continue;
+            }
+            return false;
+          }
+          p += n;
+          sent_bytes += static_cast<std::size_t>(n);
+        }
+        discard();
+        return true;
+      }
+
+      int fd;
+      std::vector<char> buffer;
+      std::size_t sent_bytes = 0;
+    };
+
+    // Lee la línea de petición (sin el '\n'); vacía si el cliente cierra sin enviar nada
+    std::string read_request(int fd) {
+      std::string line;
+      std::array<char, 512> chunk{};
+      while (line.size() <= max_request) {
+        auto const n = ::recv(fd, chunk.data(), chunk.size(), 0);
+        if (n < 0 and errno == EINTR) {
+          continue;
+        }
+        if (n <= 0) {
+          return line;
+        }
+        line.append(chunk.data(), static_cast<std::size_t>(n));
+        if (auto const nl = line.find('\n'); nl != std::string::npos) {
+          line.resize(nl);
+          return line;
+        }
+      }
+      throw std::runtime_error("Error: Request too long");
+    }
+
+    unique_fd listen_on(std::string const & path) {
+      sockaddr_un addr{};
+      if (path.size() >= sizeof(addr.sun_path)) {
+        throw std::runtime_error("Error: Socket path too long: [" + path + "]");
+      }
+      addr.sun_family = AF_UNIX;
+      std::memcpy(addr.sun_path, path.c_str(), path.size() + 1);
+
+      // Un socket de una ejecución anterior se sustituye; cualquier otro fichero se conserva
+      struct stat st{};
+      if (::lstat(path.c_str(), &st) == 0) {
+        if (not S_ISSOCK(st.st_mode)) {
+          throw std::runtime_error("Error: Could not listen on socket: [" + path +
+                                   "]: Not a socket");
+        }
+        ::unlink(path.c_str());
+      }
+      unique_fd sock(::socket(AF_UNIX, SOCK_STREAM | SOCK_CLOEXEC, 0));
+      if ((sock.get() < 0) or
+          (::bind(sock.get(), reinterpret_cast<sockaddr const *>(&addr), sizeof(addr)) != 0) or
+          (::listen(sock.get(), SOMAXCONN) != 0)) {
+        throw std::runtime_error("Error: Could not listen on socket: [" + path + "]: " +
+                                 std::strerror(errno));
+      }
+      return sock;
+    }
+
+    // Atiende una conexión; devuelve false si el cliente pide detener el servidor
+    bool handle(int fd, render_handler const & handler, std::ostream & log) {
+      socket_buf buf(fd);
+      std::ostream out(&buf);
+      std::string line;
+      try {
+        line = read_request(fd);
+        if (line == "quit") {
+          return false;
+        }
+        render_request const req = parse_request(line);
+        stopwatch const clock;
+        handler(req, out);
+        out.flush();
+        log << "Served " << req.config_path << " " << req.scene_path << " (" << clock.seconds()
+            << " s)\n";
+      } catch (std::exception const & e) {
+        if (buf.sent() == 0) {
+          buf.discard();
+          out.clear();
+          out << e.what() << "\n";
+          out.flush();
+        }
+        log << e.what() << "\n";
+      }
+      return true;
+    }
+
+  }  // namespace
+
+  render_request parse_request(std::string_view line) {
+    std::vector<std::string> fields;
+    std::size_t i = 0;
+    while (i < line.size()) {
+      while ((i < line.size()) and is_blank(line[i])) {
+        ++i;
+      }
+      std::size_t const start = i;
+      while ((i < line.size()) and not is_blank(line[i])) {
+        ++i;
+      }
+      if (i > start) {
+        fields.emplace_back(line.substr(start, i - start));
+      }
+    }
+    if (fields.size() != 2) {
+      throw std::runtime_error("Error: Invalid request: [" + std::string(line) + "]");
+    }
+    return {std::move(fields[0]), std::move(fields[1])};
+  }
+
+  scene_key scene_file_key(std::string const & path) {
+    mapped_file const file(path);
+    return {checksum(file.view()), file.view().size()};
+  }
+
+  void serve(std::string const & socket_path, render_handler const & handler, std::ostream & log) {
+    unique_fd const sock = listen_on(socket_path);
+    log << "Listening on " << socket_path << std::endl;
+    bool running = true;
+    while (running) {
+      unique_fd const client(::accept4(sock.get(), nullptr, nullptr, SOCK_CLOEXEC));
+      if (client.get() < 0) {
+        if (errno == EINTR) {
+          continue;
+        }
+        ::unlink(socket_path.c_str());
+        throw std::runtime_error("Error: Could not accept connection: " +
+                                 std::string(std::strerror(errno)));
+      }
+      running = handle(client.get(), handler, log);
+      log.flush();
+    }
+    ::unlink(socket_path.c_str());
+  }
+
+}  // namespace render
@@ -0,0 +1,20 @@
+#include "rng.hpp"
+
+namespace render {
+
+  namespace {
+
+    std::uint64_t splitmix64(std::uint64_t x) {
+      x += 0x9E37'79B9'7F4A'7C15ULL;
+      x  = (x ^ (x >> 30U)) * 0xBF58'476D'1CE4'E5B9ULL;
+      x  = (x ^ (x >> 27U)) * 0x94D0'49BB'1331'11EBULL;
+      return x ^ (x >> 31U);
+    }
+
+  }  // namespace
+
+  std::uint64_t rng_key(int seed) {
+    return splitmix64(static_cast<std::uint64_t>(seed));
+  }
+
+}  // namespace render
@@ -0,0 +1,328 @@
+#include "scene_cache.hpp"
+
+#include "checksum.hpp"
+#include "mapped_file.hpp"
+
+#include <algorithm>
+#include <array>
+#include <cstring>
+#include <fstream>
+#include <stdexcept>
+#include <string_view>
+#include <type_traits>
+#include <utility>
+
+namespace render {
+
+  namespace {
+
+    // Firma al estilo PNG: el byte alto y el fin de línea la distinguen de una escena de texto
+    constexpr std::array<char, 8> magic = {'\x89', 'R', 'S', 'C', 'N', '\r', '\n', '\x1a'};
+
+    // Se guarda tal cual en el fichero: al leerlo en una máquina de otro orden de bytes no coincide
+    constexpr std::uint32_t byte_order_mark = 0x01020304;
+
+    constexpr std::size_t header_size     = 64;
+    constexpr std::size_t section_align   = 64;
+    constexpr std::size_t object_columns  = 7;
+    constexpr std::uint32_t object_params = 16;
+    constexpr std::uint32_t bvh_sections  = 32;
+
+    struct file_header {
+      std::array<char, 8> signature;
+      std::uint32_t version;
+      std::uint32_t byte_order;
+      std::uint64_t file_size;
+      std::uint64_t checksum;  // de todo lo que sigue a la cabecera
+      std::uint32_t section_count;
+      std::uint32_t reserved;
+    };
+
+    static_assert(sizeof(file_header) <= header_size);
+
+    // Entrada del directorio: qué sección es, dónde empieza y cuántos elementos tiene
+    struct section_entry {
+      std::uint32_t id;
+      std::uint32_t element_size;
+      std::uint64_t offset;
+      std::uint64_t count;
+    };
+
+    // Secciones fijas. Los parámetros ocupan object_params + k y cada jerarquía dos secciones,
+    // nodos y permutación, a partir de bvh_sections + 2 * kind.
+    enum section_id : std::uint32_t {
+      material_records = 1,
+      material_names   = 2,
+      object_types     = 3,
+      object_materials = 4,
+      object_lines     = 5,
+    };
+
+    struct material_record {
+      std::uint32_t type;
+      std::uint32_t name_offset;
+      std::uint32_t name_size;
+      std::uint32_t reserved;
+      std::array<double, 4> params;
+    };
+
+    std::uint32_t bvh_nodes_id(cached_bvh kind) {
+      return bvh_sections + 2 * static_cast<std::uint32_t>(kind);
+    }
+
+    std::uint32_t bvh_order_id(cached_bvh kind) {
+      return bvh_nodes_id(kind) + 1;
+    }
+
+    constexpr std::array<cached_bvh, 3> all_hierarchies = {
+      cached_bvh::aos, cached_bvh::soa_spheres, cached_bvh::soa_cylinders};
+
+    std::size_t align_up(std::size_t n) {
+      return (n + section_align - 1) / section_align * section_align;
+    }
+
+    // Reúne las secciones y las vuelca en un único búfer con el directorio delante
+    class cache_builder {
+    public:
+      template <typename T>
+      void add(std::uint32_t id, std::span<T const> values) {
+        static_assert(std::is_trivially_copyable_v<T>);
+        sections.push_back({
+          {id, static_cast<std::uint32_t>(sizeof(T)), 0, values.size()},
+          reinterpret_cast<char const *>(values.data())
+        });
+      }
+
+      [[nodiscard]] std::string finish() {
+        std::size_t size = align_up(header_size + sections.size() * sizeof(section_entry));
+        for (auto & s : sections) {
+          s.entry.offset = size;
+          size           = align_up(size + s.entry.count * s.entry.element_size);
+        }
+        std::string out(size, '\0');
+        for (std::size_t i = 0; i < sections.size(); ++i) {
+          auto const & s = sections[i];
+          std::memcpy(out.data() + header_size + i * sizeof(section_entry), &s.entry,
+                      sizeof(section_entry));
+          if (s.entry.count > 0) {
+            std::memcpy(out.data() + s.entry.offset, s.data, s.entry.count * s.entry.element_size);
+          }
+        }
+        file_header const header{magic,
+                                 scene_cache_version,
+                                 byte_order_mark,
+                                 size,
+                                 checksum(std::string_view(out).substr(header_size)),
+                                 static_cast<std::uint32_t>(sections.size()),
+                                 0};
+        std::memcpy(out.data(), &header, sizeof(header));
+        return out;
+      }
+
+    private:
+      struct pending {
+        section_entry entry;
+        char const * data;
+      };
+
+      std::vector<pending> sections;
+    };
+
+    // Acceso validado a las secciones del fichero proyectado
+    class cache_reader {
+    public:
+      cache_reader(std::string_view bytes, std::string const & path)
+          : data{bytes}, corrupt{"Error: Corrupt scene cache: [" + path + "]"} {
+        file_header header{};
+        if (data.size() < header_size) {
+          throw corrupt;
+        }
+        std::memcpy(&header, data.data(), sizeof(header));
+        if (header.signature != magic) {
+          throw corrupt;
+        }
+        if ((header.version != scene_cache_version) or (header.byte_order != byte_order_mark)) {
+          throw std::runtime_error("Error: Unsupported scene cache version: [" + path + "]");
+        }
+        if ((header.file_size != data.size()) or
+            (header.checksum != checksum(data.substr(header_size))) or
+            (header.section_count > (data.size() - header_size) / sizeof(section_entry))) {
+          throw corrupt;
+        }
+        entries.resize(header.section_count);
+        std::memcpy(entries.data(), data.data() + header_size,
+                    entries.size() * sizeof(section_entry));
+      }
+
+      [[nodiscard]] bool has(std::uint32_t id) const { return find(id) != nullptr; }
+
+      // Copia la sección id; si expected no es nulo, exige ese número de elementos
+      template <typename T>
+      [[nodiscard]] std::vector<T> read(std::uint32_t id,
+                                        std::optional<std::size_t> expected = {}) const {
+        section_entry const * const e = find(id);
+        if ((e == nullptr) or (e->element_size != sizeof(T)) or (e->offset > data.size()) or
+            (e->count > (data.size() - e->offset) / sizeof(T)) or
+            (expected and (e->count != *expected))) {
+          throw corrupt;
+        }
+        std::vector<T> values(static_cast<std::size_t>(e->count));
+        if (not values.empty()) {
+          std::memcpy(values.data(), data.data() + e->offset, values.size() * sizeof(T));
+        }
+        return values;
+      }
+
+      [[nodiscard]] std::runtime_error const & error() const { return corrupt; }
+
+    private:
+      [[nodiscard]] section_entry const * find(std::uint32_t id) const {
+        auto const it = std::ranges::find(entries, id, &section_entry::id);
+        return (it == entries.end()) ? nullptr : &*it;
+      }
+
+      std::string_view data;
+      std::runtime_error corrupt;
+      std::vector<section_entry> entries;
+    };
+
+    std::vector<Material> read_materials(cache_reader const & reader) {
+      auto const records = reader.read<material_record>(material_records);
+      auto const names   = reader.read<char>(material_names);
+      std::vector<Material> materials;
+      materials.reserve(records.size());
+      for (auto const & rec : records) {
+        if ((rec.type > static_cast<std::uint32_t>(MaterialType::Refractive)) or
+            (rec.name_offset > names.size()) or (rec.name_size > names.size() - rec.name_offset)) {
+          throw reader.error();
+        }
+        materials.push_back({std::string(names.data() + rec.name_offset, rec.name_size),
+                             static_cast<MaterialType>(rec.type), rec.params});
+      }
+      return materials;
+    }
+
+    std::vector<Object> read_objects(cache_reader const & reader, std::size_t material_count) {
+      auto const types = reader.read<std::uint32_t>(object_types);
+      std::size_t const count = types.size();
+      auto const mats  = reader.read<std::uint32_t>(object_materials, count);
+      auto const lines = reader.read<std::uint64_t>(object_lines, count);
+      std::array<std::vector<double>, object_columns> params;
+      for (std::size_t k = 0; k < object_columns; ++k) {
+        params[k] = reader.read<double>(object_params + static_cast<std::uint32_t>(k), count);
+      }
+
+      std::vector<Object> objects(count);
+      for (std::size_t i = 0; i < count; ++i) {
+        if ((types[i] > static_cast<std::uint32_t>(ObjectType::Cylinder)) or
+            (mats[i] >= material_count)) {
+          throw reader.error();
+        }
+        objects[i].type           = static_cast<ObjectType>(types[i]);
+        objects[i].material_index = mats[i];
+        objects[i].line_offset    = lines[i];
+      }
+      for (std::size_t k = 0; k < object_columns; ++k) {
+        for (std::size_t i = 0; i < count; ++i) {
+          objects[i].params[k] = params[k][i];
+        }
+      }
+      return objects;
+    }
+
+  }  // namespace
+
+  void write_scene_cache(std::string const & path, std::vector<Material> const & materials,
+                         std::vector<Object> const & objects,
+                         std::span<cache_hierarchy const> hierarchies) {
+    std::vector<material_record> records;
+    std::string names;
+    records.reserve(materials.size());
+    for (auto const & mat : materials) {
+      records.push_back({static_cast<std::uint32_t>(mat.type),
+                         static_cast<std::uint32_t>(names.size()),
+                         static_cast<std::uint32_t>(mat.name.size()), 0, mat.params});
+      names += mat.name;
+    }
+
+    // Una columna por atributo: cada sección es un array homogéneo, como en la escena SoA
+    std::vector<std::uint32_t> types(objects.size());
+    std::vector<std::uint32_t> mats(objects.size());
+    std::vector<std::uint64_t> lines(objects.size());
+    std::array<std::vector<double>, object_columns> params;
+    for (auto & column : params) {
+      column.resize(objects.size());
+    }
+    for (std::size_t i = 0; i < objects.size(); ++i) {
+      types[i] = static_cast<std::uint32_t>(objects[i].type);
+      mats[i]  = objects[i].material_index;
+      lines[i] = objects[i].line_offset;
+      for (std::size_t k = 0; k < object_columns; ++k) {
+        params[k][i] = objects[i].params[k];
+      }
+    }
+
+    cache_builder builder;
+    builder.add(material_records, std::span<material_record const>(records));
+    builder.add(material_names, std::span<char const>(names));
+    builder.add(object_types, std::span<std::uint32_t const>(types));
+    builder.add(object_materials, std::span<std::uint32_t const>(mats));
+    builder.add(object_lines, std::span<std::uint64_t const>(lines));
+    for (std::size_t k = 0; k < object_columns; ++k) {
+      builder.add(object_params + static_cast<std::uint32_t>(k),
+                  std::span<double const>(params[k]));
+    }
+    for (auto const & h : hierarchies) {
+      if ((h.hierarchy == nullptr) or h.hierarchy->empty()) {
+        continue;
+      }
+      builder.add(bvh_nodes_id(h.kind), std::span<bvh_node const>(h.hierarchy->get_nodes()));
+      builder.add(bvh_order_id(h.kind),
+                  std::span<std::uint32_t const>(h.hierarchy->get_order()));
+    }
+
+    std::string const bytes = builder.finish();
+    std::ofstream out(path, std::ios::binary);
+    out.write(bytes.data(), static_cast<std::streamsize>(bytes.size()));
+    if (not out) {
+      throw std::runtime_error("Error: Could not write scene cache: [" + path + "]");
+    }
+  }
+
+  bool is_scene_cache(std::string const & path) {
+    std::ifstream in(path, std::ios::binary);
+    std::array<char, magic.size()> head{};
+    in.read(head.data(), static_cast<std::streamsize>(head.size()));
+    return in and (head == magic);
+  }
+
+  scene_cache::scene_cache(std::string const & path) {
+    mapped_file const file(path);
+    cache_reader const reader(file.view(), path);
+    materials = read_materials(reader);
+    objects   = read_objects(reader, materials.size());
+
+    hierarchies.resize(all_hierarchies.size());
+    for (cached_bvh const kind : all_hierarchies) {
+      if (not reader.has(bvh_nodes_id(kind))) {
+        continue;
+      }
+      try {
+        hierarchies[static_cast<std::size_t>(kind)].emplace(
+            reader.read<bvh_node>(bvh_nodes_id(kind)),
+            reader.read<std::uint32_t>(bvh_order_id(kind)));
+      } catch (std::runtime_error const &) {
+        throw reader.error();
+      }
+    }
+  }
+
+  bvh const * scene_cache::find_hierarchy(cached_bvh kind) const {
+    auto const idx = static_cast<std::size_t>(kind);
+    if ((idx >= hierarchies.size()) or not hierarchies[idx]) {
+      return nullptr;
+    }
+    return &*hierarchies[idx];
+  }
+
+}  // namespace render
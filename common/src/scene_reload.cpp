@@ -0,0 +1,53 @@
+#include "scene_reload.hpp"
+
+namespace render {
+
+  namespace {
+
+    // Fracción máxima de objetos modificados para reajustar el BVH en lugar de reconstruirlo
+    constexpr double max_refit_fraction = 0.25;
+
+    bool same_material(Material const & a, Material const & b) {
+      return (a.type == b.type) and (a.params == b.params);
+    }
+
+    bool same_object(Object const & a, Object const & b) {
+      return (a.material_index == b.material_index) and (a.params == b.params);
+    }
+
+  }  // namespace
+
+  bool scene_diff::refittable(std::size_t object_count) const {
+    return not structural and (static_cast<double>(objects.size()) <=
+                               max_refit_fraction * static_cast<double>(object_count));
+  }
+
+  scene_diff diff_scenes(std::vector<Material> const & old_materials,
+                         std::vector<Object> const & old_objects,
+                         std::vector<Material> const & new_materials,
+                         std::vector<Object> const & new_objects) {
+    scene_diff diff;
+    if ((old_materials.size() != new_materials.size()) or
+        (old_objects.size() != new_objects.size())) {
+      diff.structural = true;
+      return diff;
+    }
+    for (std::size_t i = 0; i < new_materials.size(); ++i) {
+      if (not same_material(old_materials[i], new_materials[i])) {
+        diff.materials.push_back(static_cast<std::uint32_t>(i));
+      }
+    }
+    for (std::size_t i = 0; i < new_objects.size(); ++i) {
+      if (old_objects[i].type != new_objects[i].type) {
+        diff.structural = true;
+        diff.objects.clear();
+        return diff;
+      }
+      if (not same_object(old_objects[i], new_objects[i])) {
+        diff.objects.push_back(static_cast<std::uint32_t>(i));
+      }
+    }
+    return diff;
+  }
+
+}  // namespace render
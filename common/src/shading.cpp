@@ -0,0 +1,25 @@
+#include "shading.hpp"
+
+namespace render {
+
+  surface make_surface(Material const & mat) {
+    switch (mat.type) {
+      case MaterialType::Matte:
+        return {mat.type, {mat.params[0], mat.params[1], mat.params[2]}, 0.0};
+      case MaterialType::Metal:
+        return {mat.type, {mat.params[0], mat.params[1], mat.params[2]}, mat.params[3]};
+      case MaterialType::Refractive:
+        return {mat.type, {1.0, 1.0, 1.0}, mat.params[0]};
+    }
+    return {mat.type, {}, 0.0};
+  }
+
+  vector background(Config const & cfg, ray const & r) {
+    double const m   = (r.direction.normalized().get_y() + 1.0) / 2.0;
+    auto const & lgt = cfg.background_light_color;
+    auto const & drk = cfg.background_dark_color;
+    return {(1.0 - m) * lgt[0] + m * drk[0], (1.0 - m) * lgt[1] + m * drk[1],
+            (1.0 - m) * lgt[2] + m * drk[2]};
+  }
+
+}  // namespace render
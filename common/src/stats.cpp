@@ -0,0 +1,128 @@
+#include "stats.hpp"
+
+#include <algorithm>
+#include <array>
+#include <charconv>
+#include <type_traits>
+
+namespace render {
+
+  namespace {
+
+    // Número en la representación más corta que se relee sin pérdida
+    std::string number(double value) {
+      std::array<char, 32> buf{};
+      auto const [ptr, ec] = std::to_chars(buf.data(), buf.data() + buf.size(), value);
+      return (ec == std::errc{}) ? std::string(buf.data(), ptr) : std::string("0");
+    }
+
+    double ratio(double num, double den) {
+      return (den > 0.0) ? num / den : 0.0;
+    }
+
+    template <typename T>
+    void write_array(std::ostream & out, std::vector<T> const & values) {
+      out << '[';
+      for (std::size_t i = 0; i < values.size(); ++i) {
+        out << (i == 0 ? "" : ", ");
+        if constexpr (std::is_floating_point_v<T>) {
+          out << number(values[i]);
+        } else {
+          out << values[i];
+        }
+      }
+      out << ']';
+    }
+
+  }  // namespace
+
+  ray_stats::ray_stats(int max_depth) : path_lengths(static_cast<std::size_t>(max_depth) + 1, 0) {}
+
+  void ray_stats::merge(ray_stats const & other) {
+    primary += other.primary;
+    secondary += other.secondary;
+    shadow += other.shadow;
+    box_tests += other.box_tests;
+    primitive_tests += other.primitive_tests;
+    if (path_lengths.size() < other.path_lengths.size()) {
+      path_lengths.resize(other.path_lengths.size(), 0);
+    }
+    for (std::size_t k = 0; k < other.path_lengths.size(); ++k) {
+      path_lengths[k] += other.path_lengths[k];
+    }
+  }
+
+  void render_stats::merge(render_stats const & other) {
+    rays.merge(other.rays);
+    if (busy_seconds.size() < other.busy_seconds.size()) {
+      busy_seconds.resize(other.busy_seconds.size(), 0.0);
+      tiles.resize(other.tiles.size(), 0);
+    }
+    for (std::size_t i = 0; i < other.busy_seconds.size(); ++i) {
+      busy_seconds[i] += other.busy_seconds[i];
+      tiles[i] += other.tiles[i];
+    }
+    render_seconds += other.render_seconds;
+  }
+
+  tile_stats_sink::tile_stats_sink(render_stats & out, int max_depth, unsigned threads)
+      : stats{out} {
+    stats.rays = ray_stats(max_depth);
+    stats.busy_seconds.assign(threads, 0.0);
+    stats.tiles.assign(threads, 0);
+  }
+
+  void tile_stats_sink::add(ray_stats const & rays, unsigned worker, double seconds) {
+    std::lock_guard const lock(mtx);
+    stats.rays.merge(rays);
+    if (worker < stats.busy_seconds.size()) {
+      stats.busy_seconds[worker] += seconds;
+      ++stats.tiles[worker];
+    }
+  }
+
+  void write_stats_json(std::ostream & out, run_report const & report) {
+    phase_times const & ph = report.phases;
+    ray_stats const & rays = report.render.rays;
+    double const traced    = static_cast<double>(rays.primary + rays.secondary + rays.shadow);
+    double const wall      = report.render.render_seconds;
+
+    out << "{\n";
+    out << "  \"engine\": \"" << report.engine << "\",\n";
+    out << "  \"image\": {\"width\": " << report.width << ", \"height\": " << report.height
+        << ", \"samples_per_pixel\": " << report.samples << ", \"max_depth\": "
+        << report.max_depth << "},\n";
+    out << "  \"phases_seconds\": {\"config_parse\": " << number(ph.config_parse)
+        << ", \"scene_load\": " << number(ph.scene_load)
+        << ", \"scene_build\": " << number(ph.scene_build)
+        << ", \"accel_build\": " << number(ph.accel_build)
+        << ", \"render\": " << number(ph.render) << ", \"write\": " << number(ph.write)
+        << "},\n";
+    out << "  \"rays\": {\"primary\": " << rays.primary << ", \"secondary\": " << rays.secondary
+        << ", \"shadow\": " << rays.shadow << ", \"per_second\": " << number(ratio(traced, wall))
+        << "},\n";
+    out << "  \"tests_per_ray\": {\"box\": "
+        << number(ratio(static_cast<double>(rays.box_tests), traced))
+        << ", \"primitive\": " << number(ratio(static_cast<double>(rays.primitive_tests), traced))
+        << "},\n";
+    // path_length[k]: caminos de k segmentos; el último elemento son los que agotaron max_depth
+    out << "  \"path_length_histogram\": ";
+    write_array(out, rays.path_lengths);
+    out << ",\n";
+
+    std::vector<double> utilisation;
+    for (double const busy : report.render.busy_seconds) {
+      utilisation.push_back(std::min(ratio(busy, wall), 1.0));
+    }
+    out << "  \"threads\": {\"count\": " << report.render.busy_seconds.size()
+        << ", \"busy_seconds\": ";
+    write_array(out, report.render.busy_seconds);
+    out << ", \"utilisation\": ";
+    write_array(out, utilisation);
+    out << ", \"tiles\": ";
+    write_array(out, report.render.tiles);
+    out << "}\n";
+    out << "}\n";
+  }
+
+}  // namespace render
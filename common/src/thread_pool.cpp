@@ -0,0 +1,133 @@
+#include "thread_pool.hpp"
+
+#include <algorithm>
+
+namespace render {
+
+  namespace {
+
+    thread_local unsigned worker_id = 0;
+
+  }  // namespace
+
+  work_stealing_pool::work_stealing_pool(unsigned threads) {
+    unsigned const n = std::max(threads, 1U);
+    for (unsigned i = 0; i < n; ++i) {
+      queues.push_back(std::make_unique<task_queue>());
+    }
+    for (unsigned i = 0; i < n; ++i) {
+      workers.emplace_back([this, i](std::stop_token const & stop) { worker_loop(stop, i); });
+    }
+  }
+
+  work_stealing_pool::~work_stealing_pool() {
+    for (auto & w : workers) {
+      w.request_stop();
+    }
+    start_cv.notify_all();
+  }
+
+  void work_stealing_pool::run(std::size_t count, std::function<void(std::size_t)> const & task) {
+    if (count == 0) {
+      return;
+    }
+    {
+      std::lock_guard const lock(mtx);
+      current = &task;
+      pending = count;
+      error   = nullptr;
+    }
+    // Bloques contiguos por hilo: las tareas vecinas (teselas adyacentes) comparten caché
+    std::size_t const n = queues.size();
+    for (std::size_t q = 0; q < n; ++q) {
+      std::lock_guard const lock(queues[q]->mtx);
+      for (std::size_t i = q * count / n; i < (q + 1) * count / n; ++i) {
+        queues[q]->tasks.push_back(i);
+      }
+    }
+    // La nueva generación se publica con las colas ya llenas: un hilo que despierte antes
+    // encontraría las colas vacías y volvería a dormir sin tareas pendientes de aviso
+    {
+      std::lock_guard const lock(mtx);
+      ++generation;
+    }
+    start_cv.notify_all();
+
+    std::unique_lock lock(mtx);
+    done_cv.wait(lock, [this] { return pending == 0; });
+    current = nullptr;
+    if (error) {
+      std::rethrow_exception(error);
+    }
+  }
+
+  bool work_stealing_pool::next_task(unsigned id, std::size_t & task) {
+    {
+      auto & own = *queues[id];
+      std::lock_guard const lock(own.mtx);
+      if (not own.tasks.empty()) {
+        task = own.tasks.front();
+        own.tasks.pop_front();
+        return true;
+      }
+    }
+    std::size_t const n = queues.size();
+    for (std::size_t k = 1; k < n; ++k) {
+      auto & victim = *queues[(id + k) % n];
+      std::lock_guard const lock(victim.mtx);
+      if (not victim.tasks.empty()) {
+        task = victim.tasks.back();
+        victim.tasks.pop_back();
+        return true;
+      }
+    }
+    return false;
+  }
+
+  unsigned work_stealing_pool::current_worker() {
+    return worker_id;
+  }
+
+  void work_stealing_pool::worker_loop(std::stop_token const & stop, unsigned id) {
+    worker_id          = id;
+    std::uint64_t seen = 0;
+    while (true) {
+      {
+        std::unique_lock lock(mtx);
+        start_cv.wait(lock, stop, [&] { return generation != seen; });
+        if (stop.stop_requested()) {
+          return;
+        }
+        seen = generation;
+      }
+      std::size_t task = 0;
+      while (next_task(id, task)) {
+        std::function<void(std::size_t)> const * fn = nullptr;
+        {
+          std::lock_guard const lock(mtx);
+          fn = current;
+        }
+        try {
+          (*fn)(task);
+        } catch (...) {
+          std::lock_guard const lock(mtx);
+          if (not error) {
+            error = std::current_exception();
+          }
+        }
+        std::lock_guard const lock(mtx);
+        if (--pending == 0) {
+          done_cv.notify_all();
+        }
+      }
+    }
+  }
+
+  unsigned resolve_thread_count(int requested) {
+    if (requested > 0) {
+      return static_cast<unsigned>(requested);
+    }
+    return std::max(std::thread::hardware_concurrency(), 1U);
+  }
+
+}  // namespace render
@@ -0,0 +1,47 @@
+#include "tiles.hpp"
+
+#include <algorithm>
+#include <utility>
+
+namespace render {
+
+  std::vector<tile> make_tiles(int width, int height, int size) {
+    std::vector<tile> tiles;
+    for (int row = 0; row < height; row += size) {
+      for (int col = 0; col < width; col += size) {
+        tiles.push_back({row, col, std::min(size, height - row), std::min(size, width - col)});
+      }
+    }
+    return tiles;
+  }
+
+  band_tracker::band_tracker(std::vector<tile> const & tiles, framebuffer const & image,
+                             tone_mapper const & mapper, row_sink sink)
+      : image{image}, mapper{mapper}, sink{std::move(sink)} {
+    // Las teselas vienen ordenadas por filas: una franja por cada row0 distinto
+    band_of_tile.reserve(tiles.size());
+    for (auto const & t : tiles) {
+      if (bands.empty() or (bands.back().row0 != t.row0)) {
+        bands.push_back({t.row0, t.rows, 0});
+      }
+      ++bands.back().remaining;
+      band_of_tile.push_back(bands.size() - 1);
+    }
+  }
+
+  void band_tracker::tile_done(std::size_t t) {
+    if (not sink) {
+      return;
+    }
+    std::lock_guard const lock(mtx);
+    --bands[band_of_tile[t]].remaining;
+    while ((next_band < bands.size()) and (bands[next_band].remaining == 0)) {
+      band const & b = bands[next_band];
+      packed.resize(image.index(b.rows, 0));
+      image.pack_rows(b.row0, b.rows, mapper, packed);
+      sink(packed);
+      ++next_band;
+    }
+  }
+
+}  // namespace render
@@ -27,7 +27,7 @@ int main(int argc, char ** argv) {
     std::cout << "Objects: " << objs.size() << "\n";
     for (auto & o : objs) {
       std::cout << " - " << (o.type == ObjectType::Sphere ? "Sphere" : "Cylinder")
-                << " material=" << o.material << "\n";
+                << " material=" << mats[o.material_index].name << "\n";
     }
     return 0;
   } catch (std::exception const & e) {
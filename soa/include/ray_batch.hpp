@@ -0,0 +1,89 @@
+#ifndef RENDER_SOA_RAY_BATCH_HPP
+#define RENDER_SOA_RAY_BATCH_HPP
+
+#include "ray.hpp"
+#include "vector.hpp"
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace render::soa {
+
+  // Lote de rayos en formato SoA: origen y dirección por componentes
+  struct ray_batch {
+    std::vector<double> ox, oy, oz;
+    std::vector<double> dx, dy, dz;
+
+    void resize(std::size_t n) {
+      ox.resize(n);
+      oy.resize(n);
+      oz.resize(n);
+      dx.resize(n);
+      dy.resize(n);
+      dz.resize(n);
+    }
+
+    [[nodiscard]] std::size_t size() const { return ox.size(); }
+
+    void set(std::size_t i, ray const & r) {
+      ox[i] = r.origin.get_x();
+      oy[i] = r.origin.get_y();
+      oz[i] = r.origin.get_z();
+      dx[i] = r.direction.get_x();
+      dy[i] = r.direction.get_y();
+      dz[i] = r.direction.get_z();
+    }
+
+    [[nodiscard]] ray get(std::size_t i) const {
+      return {
+        {ox[i], oy[i], oz[i]},
+        {dx[i], dy[i], dz[i]}
+      };
+    }
+  };
+
+  // Caminos vivos de un frente de onda: rayo actual, atenuación acumulada y posición de su
+  // muestra en la ronda, en arrays separados. Se rellena de nuevo, compactado, en cada rebote.
+  struct path_batch {
+    ray_batch rays;
+    std::vector<double> tr, tg, tb;
+    std::vector<std::uint32_t> slot;
+
+    [[nodiscard]] std::size_t size() const { return slot.size(); }
+
+    [[nodiscard]] bool empty() const { return slot.empty(); }
+
+    void reserve(std::size_t n) {
+      for (auto * v : {&rays.ox, &rays.oy, &rays.oz, &rays.dx, &rays.dy, &rays.dz, &tr, &tg, &tb}) {
+        v->reserve(n);
+      }
+      slot.reserve(n);
+    }
+
+    void clear() {
+      for (auto * v : {&rays.ox, &rays.oy, &rays.oz, &rays.dx, &rays.dy, &rays.dz, &tr, &tg, &tb}) {
+        v->clear();
+      }
+      slot.clear();
+    }
+
+    void push(ray const & r, vector const & throughput, std::uint32_t sample_slot) {
+      rays.ox.push_back(r.origin.get_x());
+      rays.oy.push_back(r.origin.get_y());
+      rays.oz.push_back(r.origin.get_z());
+      rays.dx.push_back(r.direction.get_x());
+      rays.dy.push_back(r.direction.get_y());
+      rays.dz.push_back(r.direction.get_z());
+      tr.push_back(throughput.get_x());
+      tg.push_back(throughput.get_y());
+      tb.push_back(throughput.get_z());
+      slot.push_back(sample_slot);
+    }
+
+    [[nodiscard]] vector throughput(std::size_t i) const { return {tr[i], tg[i], tb[i]}; }
+  };
+
+}  // namespace render::soa
+
+#endif
@@ -0,0 +1,41 @@
+#ifndef RENDER_SOA_RENDERER_HPP
+#define RENDER_SOA_RENDERER_HPP
+
+#include "framebuffer.hpp"
+#include "parser.hpp"
+#include "progressive.hpp"
+#include "scene.hpp"
+#include "stats.hpp"
+#include "thread_pool.hpp"
+#include "tiles.hpp"
+
+#include <string>
+
+namespace render::soa {
+
+  // Recorrido de los caminos: cada muestra de principio a fin (recursive) o todas las de una
+  // ronda rebote a rebote, con una cola de sombreado por tipo de material (wavefront). Los dos
+  // dan la misma imagen.
+  enum class integrator { recursive, wavefront };
+
+  // Lanza std::runtime_error si el nombre no corresponde a ningún integrador
+  integrator parse_integrator(std::string const & name);
+
+  // Renderiza la escena por trazado de caminos y devuelve la imagen en color lineal.
+  // Las teselas de la imagen se reparten entre los hilos de pool; si se indica on_rows, recibe
+  // cada franja de filas terminada, ya en RGB de 8 bits, mientras continúa el render del resto.
+  // Si se indica stats, cuenta rayos y pruebas de intersección y mide la ocupación de cada hilo.
+  framebuffer render_image(Config const & cfg, scene const & scn, int width, int height,
+                           work_stealing_pool & pool, row_sink const & on_rows = {},
+                           render_stats * stats = nullptr, integrator mode = integrator::recursive);
+
+  // Una pasada del render progresivo: añade a cada píxel de state hasta state.pass_samples
+  // muestras, sin pasar de samples_per_pixel, salvo a los que ya cumplen adaptive_threshold.
+  // Si se indica stats, suma a él lo contado en la pasada.
+  void render_pass(Config const & cfg, scene const & scn, progress_state & state,
+                   work_stealing_pool & pool, render_stats * stats = nullptr,
+                   integrator mode = integrator::recursive);
+
+}  // namespace render::soa
+
+#endif
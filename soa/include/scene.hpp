@@ -0,0 +1,171 @@
+#ifndef RENDER_SOA_SCENE_HPP
+#define RENDER_SOA_SCENE_HPP
+
+#include "bvh.hpp"
+#include "geometry.hpp"
+#include "parser.hpp"
+#include "ray.hpp"
+#include "scene_cache.hpp"
+#include "scene_reload.hpp"
+#include "shading.hpp"
+#include "simd_kernels.hpp"
+#include "stats.hpp"
+#include "vector.hpp"
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace render::soa {
+
+  // Esferas: un array contiguo por atributo
+  struct sphere_set {
+    std::vector<double> cx, cy, cz;
+    std::vector<double> radius;
+    std::vector<int> material;
+
+    [[nodiscard]] std::size_t size() const { return radius.size(); }
+
+    [[nodiscard]] sphere_view view(std::size_t first, std::size_t count) const {
+      return {cx.data() + first, cy.data() + first, cz.data() + first, radius.data() + first,
+              count};
+    }
+
+    // Cambia el tamaño de todos los arrays a la vez
+    void resize(std::size_t n);
+    // Reordena todos los arrays según la permutación order (order[i] = índice original)
+    void reorder(std::vector<std::uint32_t> const & order);
+  };
+
+  // Cilindros: centro, eje unitario, radio y semialtura en arrays separados
+  struct cylinder_set {
+    std::vector<double> cx, cy, cz;
+    std::vector<double> ax, ay, az;
+    std::vector<double> radius;
+    std::vector<double> half_height;
+    std::vector<int> material;
+
+    [[nodiscard]] std::size_t size() const { return radius.size(); }
+
+    [[nodiscard]] cylinder_view view(std::size_t first, std::size_t count) const {
+      return {cx.data() + first,     cy.data() + first,          cz.data() + first,
+              ax.data() + first,     ay.data() + first,          az.data() + first,
+              radius.data() + first, half_height.data() + first, count};
+    }
+
+    void resize(std::size_t n);
+    void reorder(std::vector<std::uint32_t> const & order);
+  };
+
+  // Copias en float de las columnas geométricas, para los núcleos de precisión simple
+  struct sphere_set_f32 {
+    std::vector<float> cx, cy, cz;
+    std::vector<float> radius;
+
+    [[nodiscard]] sphere_view_f32 view(std::size_t first, std::size_t count) const {
+      return {cx.data() + first, cy.data() + first, cz.data() + first, radius.data() + first,
+              count};
+    }
+
+    void assign(sphere_set const & set);
+  };
+
+  struct cylinder_set_f32 {
+    std::vector<float> cx, cy, cz;
+    std::vector<float> ax, ay, az;
+    std::vector<float> radius;
+    std::vector<float> half_height;
+
+    [[nodiscard]] cylinder_view_f32 view(std::size_t first, std::size_t count) const {
+      return {cx.data() + first,     cy.data() + first,          cz.data() + first,
+              ax.data() + first,     ay.data() + first,          az.data() + first,
+              radius.data() + first, half_height.data() + first, count};
+    }
+
+    void assign(cylinder_set const & set);
+  };
+
+  // Materiales: tipo, reflectancia y parámetro en arrays separados
+  struct material_set {
+    std::vector<MaterialType> type;
+    std::vector<double> r, g, b;
+    std::vector<double> param;
+
+    [[nodiscard]] std::size_t size() const { return type.size(); }
+
+    void resize(std::size_t n);
+  };
+
+  // Escena como estructura de arrays. Con BVH hay una jerarquía por tipo de primitivo y los
+  // arrays siguen el orden de sus hojas, de modo que cada hoja es un bloque para los núcleos SIMD.
+  // En precisión f32 los núcleos recorren copias en float de la geometría y solo el impacto
+  // elegido se vuelve a calcular en double, así que t, el punto y la normal son los de double.
+  class scene {
+  public:
+    scene(std::vector<Material> const & mats, std::vector<Object> const & objects,
+          simd_level level = simd_level::automatic, accel_kind accel = accel_kind::bvh,
+          precision mode = precision::f64);
+    // Escena compilada: reutiliza las jerarquías guardadas si existen y solo las construye si no
+    explicit scene(scene_cache const & cache, simd_level level = simd_level::automatic,
+                   accel_kind accel = accel_kind::bvh, precision mode = precision::f64);
+
+    // Búsqueda de la intersección más cercana en [t_min, t_max]
+    [[nodiscard]] bool closest_hit(ray const & r, double t_min, double t_max,
+                                   hit_record & rec) const;
+
+    // Igual, contando en probe las cajas y los primitivos probados (no_probe o ray_stats)
+    template <typename Probe>
+    [[nodiscard]] bool closest_hit(ray const & r, double t_min, double t_max, hit_record & rec,
+                                   Probe & probe) const;
+
+    [[nodiscard]] surface material_at(int idx) const;
+
+    // Aplica los cambios no estructurales de diff respecto al análisis del que se construyó la
+    // escena: sustituye los materiales y objetos modificados por los de (mats, objects) y
+    // reajusta las cajas de las dos jerarquías sin reconstruirlas
+    void update(std::vector<Material> const & mats, std::vector<Object> const & objects,
+                scene_diff const & diff);
+
+    [[nodiscard]] MaterialType material_type(int idx) const {
+      return materials.type[static_cast<std::size_t>(idx)];
+    }
+
+    [[nodiscard]] sphere_set const & get_spheres() const { return spheres; }
+
+    [[nodiscard]] cylinder_set const & get_cylinders() const { return cylinders; }
+
+    [[nodiscard]] simd_level get_simd_level() const { return kernels.level; }
+
+    [[nodiscard]] precision get_precision() const { return prec; }
+
+    [[nodiscard]] bvh const & get_sphere_bvh() const { return sphere_hierarchy; }
+
+    [[nodiscard]] bvh const & get_cylinder_bvh() const { return cylinder_hierarchy; }
+
+    // Tiempo de construcción (o adopción) de las jerarquías, en segundos
+    [[nodiscard]] double get_bvh_seconds() const { return bvh_seconds; }
+
+  private:
+    // Cajas de cada primitivo en el orden actual de su array
+    [[nodiscard]] std::vector<aabb> sphere_bounds() const;
+    [[nodiscard]] std::vector<aabb> cylinder_bounds() const;
+    void build_bvh();
+    void use_bvh(bvh spheres_tree, bvh cylinders_tree);
+    // Rellena las copias en float si la precisión es f32
+    void narrow();
+
+    material_set materials;
+    sphere_set spheres;
+    cylinder_set cylinders;
+    sphere_set_f32 spheres_f32;
+    cylinder_set_f32 cylinders_f32;
+    intersect_kernels kernels;
+    precision prec;
+    bvh sphere_hierarchy;
+    bvh cylinder_hierarchy;
+    double bvh_seconds = 0.0;
+  };
+
+}  // namespace render::soa
+
+#endif
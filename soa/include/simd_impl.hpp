@@ -0,0 +1,167 @@
+#ifndef RENDER_SOA_SIMD_IMPL_HPP
+#define RENDER_SOA_SIMD_IMPL_HPP
+
+#include "geometry.hpp"
+#include "simd_kernels.hpp"
+
+#include <cstddef>
+
+// Implementación genérica de los núcleos SIMD. La incluyen simd_avx2.cpp y simd_avx512.cpp, y
+// simd_kernels.cpp para la versión escalar en float, cada una con su propio tipo V (en un
+// espacio de nombres anónimo) que define el escalar (double o float), el registro, la máscara y
+// las operaciones del conjunto de instrucciones.
+//
+// Cada operación reproduce en el mismo orden la aritmética de hit_sphere/hit_cylinder, de modo
+// que en double los valores de t coinciden bit a bit con la versión escalar y en float todas
+// las variantes coinciden entre sí.
+namespace render::soa::simd {
+
+  template <typename V>
+  struct vec3 {
+    typename V::reg x, y, z;
+  };
+
+  template <typename V>
+  typename V::reg dot(vec3<V> const & a, vec3<V> const & b) {
+    return V::add(V::add(V::mul(a.x, b.x), V::mul(a.y, b.y)), V::mul(a.z, b.z));
+  }
+
+  // Recorre las lanes con impacto en orden creciente aplicando la misma regla que el bucle
+  // escalar (t <= closest). Cada lane se evalúa con el closest del inicio del bloque, que es
+  // mayor o igual que el del recorrido escalar: un t válido aquí y <= closest actual es
+  // exactamente el que habría encontrado la versión escalar.
+  template <typename V>
+  bool reduce_lanes(typename V::reg t, unsigned bits, std::size_t base, double & closest,
+                    std::size_t & best) {
+    alignas(64) typename V::scalar lanes[V::width];
+    V::store(lanes, t);
+    bool improved = false;
+    for (std::size_t lane = 0; lane < V::width; ++lane) {
+      if ((((bits >> lane) & 1U) != 0U) and (lanes[lane] <= closest)) {
+        closest  = lanes[lane];
+        best     = base + lane;
+        improved = true;
+      }
+    }
+    return improved;
+  }
+
+  template <typename V>
+  bool spheres(ray_view const & r, basic_sphere_view<typename V::scalar> const & s, double t_min,
+               double & closest, std::size_t & best) {
+    using reg  = typename V::reg;
+    using mask = typename V::mask;
+
+    vec3<V> const o{V::set1(r.ox), V::set1(r.oy), V::set1(r.oz)};
+    vec3<V> const d{V::set1(r.dx), V::set1(r.dy), V::set1(r.dz)};
+    reg const a    = dot(d, d);
+    reg const tmin = V::set1(t_min);
+    reg const zero = V::set1(0.0);
+
+    bool improved = false;
+    for (std::size_t i = 0; i < s.count; i += V::width) {
+      mask const active = V::lanes(s.count - i);
+      vec3<V> const oc{V::sub(o.x, V::load(s.cx + i, active)),
+                       V::sub(o.y, V::load(s.cy + i, active)),
+                       V::sub(o.z, V::load(s.cz + i, active))};
+      reg const radius = V::load(s.radius + i, active);
+      reg const half_b = dot(oc, d);
+      reg const c      = V::sub(dot(oc, oc), V::mul(radius, radius));
+      reg const disc   = V::sub(V::mul(half_b, half_b), V::mul(a, c));
+      reg const sq     = V::sqrt(disc);
+      reg const neg_b  = V::neg(half_b);
+      reg const tmax   = V::set1(closest);
+      reg const t_near = V::div(V::sub(neg_b, sq), a);
+      reg const t_far  = V::div(V::add(neg_b, sq), a);
+
+      mask const near_ok = V::land(V::ge(t_near, tmin), V::le(t_near, tmax));
+      mask const far_ok  = V::land(V::ge(t_far, tmin), V::le(t_far, tmax));
+      mask const hit = V::land(active, V::land(V::ge(disc, zero), V::lor(near_ok, far_ok)));
+      if (V::bits(hit) != 0U) {
+        reg const t = V::select(near_ok, t_near, t_far);
+        improved    = reduce_lanes<V>(t, V::bits(hit), i, closest, best) or improved;
+      }
+    }
+    return improved;
+  }
+
+  template <typename V>
+  bool cylinders(ray_view const & r, basic_cylinder_view<typename V::scalar> const & c,
+                 double t_min, double & closest, std::size_t & best) {
+    using reg  = typename V::reg;
+    using mask = typename V::mask;
+
+    vec3<V> const o{V::set1(r.ox), V::set1(r.oy), V::set1(r.oz)};
+    vec3<V> const d{V::set1(r.dx), V::set1(r.dy), V::set1(r.dz)};
+    reg const tmin = V::set1(t_min);
+    reg const zero = V::set1(0.0);
+    reg const eps  = V::set1(parallel_epsilon);
+
+    bool improved = false;
+    for (std::size_t i = 0; i < c.count; i += V::width) {
+      mask const active = V::lanes(c.count - i);
+      vec3<V> const oc{V::sub(o.x, V::load(c.cx + i, active)),
+                       V::sub(o.y, V::load(c.cy + i, active)),
+                       V::sub(o.z, V::load(c.cz + i, active))};
+      vec3<V> const axis{V::load(c.ax + i, active), V::load(c.ay + i, active),
+                         V::load(c.az + i, active)};
+      reg const radius = V::load(c.radius + i, active);
+      reg const hh     = V::load(c.half_height + i, active);
+
+      reg const d_a  = dot(d, axis);
+      reg const oc_a = dot(oc, axis);
+      vec3<V> const d_p{V::sub(d.x, V::mul(axis.x, d_a)), V::sub(d.y, V::mul(axis.y, d_a)),
+                        V::sub(d.z, V::mul(axis.z, d_a))};
+      vec3<V> const oc_p{V::sub(oc.x, V::mul(axis.x, oc_a)),
+                         V::sub(oc.y, V::mul(axis.y, oc_a)),
+                         V::sub(oc.z, V::mul(axis.z, oc_a))};
+      reg const r2 = V::mul(radius, radius);
+      reg best_t   = V::set1(closest);
+
+      // Superficie lateral: la segunda raíz solo se considera si la primera no es válida
+      reg const a      = dot(d_p, d_p);
+      reg const half_b = dot(oc_p, d_p);
+      reg const cc     = V::sub(dot(oc_p, oc_p), r2);
+      reg const disc   = V::sub(V::mul(half_b, half_b), V::mul(a, cc));
+      mask const side  = V::land(V::gt(a, eps), V::ge(disc, zero));
+      reg const sq     = V::sqrt(disc);
+      reg const neg_b  = V::neg(half_b);
+      reg const root0  = V::div(V::sub(neg_b, sq), a);
+      reg const root1  = V::div(V::add(neg_b, sq), a);
+
+      auto const side_ok = [&](reg const & root) {
+        mask const in_range  = V::land(V::ge(root, tmin), V::le(root, best_t));
+        mask const in_height = V::le(V::abs(V::add(oc_a, V::mul(root, d_a))), hh);
+        return V::land(side, V::land(in_range, in_height));
+      };
+      mask const side0 = side_ok(root0);
+      mask const side1 = V::landnot(side_ok(root1), side0);
+      best_t           = V::select(side0, root0, best_t);
+      best_t           = V::select(side1, root1, best_t);
+      mask found       = V::lor(side0, side1);
+
+      // Tapas, en el mismo orden que la versión escalar (-half_height, +half_height)
+      mask const caps    = V::gt(V::abs(d_a), eps);
+      reg const sides[2] = {V::neg(hh), hh};
+      for (reg const & plane : sides) {
+        reg const root = V::div(V::sub(plane, oc_a), d_a);
+        vec3<V> const q{V::add(oc_p.x, V::mul(d_p.x, root)),
+                        V::add(oc_p.y, V::mul(d_p.y, root)),
+                        V::add(oc_p.z, V::mul(d_p.z, root))};
+        mask const cap = V::land(V::land(caps, V::land(V::ge(root, tmin), V::le(root, best_t))),
+                                 V::le(dot(q, q), r2));
+        best_t         = V::select(cap, root, best_t);
+        found          = V::lor(found, cap);
+      }
+
+      mask const hit = V::land(active, found);
+      if (V::bits(hit) != 0U) {
+        improved = reduce_lanes<V>(best_t, V::bits(hit), i, closest, best) or improved;
+      }
+    }
+    return improved;
+  }
+
+}  // namespace render::soa::simd
+
+#endif
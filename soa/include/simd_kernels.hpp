@@ -0,0 +1,120 @@
+#ifndef RENDER_SOA_SIMD_KERNELS_HPP
+#define RENDER_SOA_SIMD_KERNELS_HPP
+
+#include <cstddef>
+#include <string>
+
+// Núcleos de intersección "un rayo contra N objetos" sobre los arrays SoA.
+// Las interfaces solo usan tipos planos para que las unidades de traducción compiladas con
+// -mavx2/-mavx512f no instancien funciones inline compartidas con el resto del programa.
+namespace render::soa {
+
+  enum class simd_level { automatic, scalar, avx2, avx512 };
+
+  struct ray_view {
+    double ox, oy, oz;
+    double dx, dy, dz;
+  };
+
+  // Precisión de los núcleos: f32 recorre copias en float de las columnas (el doble de lanes
+  // por registro y la mitad de memoria); el impacto final se recalcula en double
+  enum class precision { f64, f32 };
+
+  // Columnas de un bloque de esferas o cilindros, en la precisión T
+  template <typename T>
+  struct basic_sphere_view {
+    T const * cx;
+    T const * cy;
+    T const * cz;
+    T const * radius;
+    std::size_t count;
+  };
+
+  template <typename T>
+  struct basic_cylinder_view {
+    T const * cx;
+    T const * cy;
+    T const * cz;
+    T const * ax;
+    T const * ay;
+    T const * az;
+    T const * radius;
+    T const * half_height;
+    std::size_t count;
+  };
+
+  using sphere_view       = basic_sphere_view<double>;
+  using cylinder_view     = basic_cylinder_view<double>;
+  using sphere_view_f32   = basic_sphere_view<float>;
+  using cylinder_view_f32 = basic_cylinder_view<float>;
+
+  // Actualiza closest y best con la intersección más cercana del conjunto en [t_min, closest].
+  // Devuelve true si ha encontrado alguna. Las variantes de una misma precisión dan resultados
+  // idénticos bit a bit.
+  template <typename SphereView>
+  using basic_sphere_kernel = bool (*)(ray_view const & r, SphereView const & s, double t_min,
+                                       double & closest, std::size_t & best);
+  template <typename CylinderView>
+  using basic_cylinder_kernel = bool (*)(ray_view const & r, CylinderView const & c,
+                                         double t_min, double & closest, std::size_t & best);
+
+  using sphere_kernel       = basic_sphere_kernel<sphere_view>;
+  using cylinder_kernel     = basic_cylinder_kernel<cylinder_view>;
+  using sphere_kernel_f32   = basic_sphere_kernel<sphere_view_f32>;
+  using cylinder_kernel_f32 = basic_cylinder_kernel<cylinder_view_f32>;
+
+  struct intersect_kernels {
+    simd_level level;
+    sphere_kernel spheres;
+    cylinder_kernel cylinders;
+    sphere_kernel_f32 spheres_f32;
+    cylinder_kernel_f32 cylinders_f32;
+  };
+
+  // Mejor nivel soportado por la CPU en ejecución
+  simd_level detect_simd_level();
+
+  // Núcleos para el nivel pedido, limitado al mejor nivel soportado por la CPU
+  intersect_kernels select_kernels(simd_level requested);
+
+  // Lanza std::runtime_error si el nombre no corresponde a ningún nivel
+  simd_level parse_simd_level(std::string const & name);
+  char const * simd_level_name(simd_level level);
+
+  // double o float; lanza std::runtime_error con cualquier otro nombre
+  precision parse_precision(std::string const & name);
+  char const * precision_name(precision prec);
+
+  bool spheres_scalar(ray_view const & r, sphere_view const & s, double t_min, double & closest,
+                      std::size_t & best);
+  bool cylinders_scalar(ray_view const & r, cylinder_view const & c, double t_min,
+                        double & closest, std::size_t & best);
+
+  bool spheres_scalar_f32(ray_view const & r, sphere_view_f32 const & s, double t_min,
+                          double & closest, std::size_t & best);
+  bool cylinders_scalar_f32(ray_view const & r, cylinder_view_f32 const & c, double t_min,
+                            double & closest, std::size_t & best);
+
+  bool spheres_avx2(ray_view const & r, sphere_view const & s, double t_min, double & closest,
+                    std::size_t & best);
+  bool cylinders_avx2(ray_view const & r, cylinder_view const & c, double t_min, double & closest,
+                      std::size_t & best);
+
+  bool spheres_avx2_f32(ray_view const & r, sphere_view_f32 const & s, double t_min,
+                        double & closest, std::size_t & best);
+  bool cylinders_avx2_f32(ray_view const & r, cylinder_view_f32 const & c, double t_min,
+                          double & closest, std::size_t & best);
+
+  bool spheres_avx512(ray_view const & r, sphere_view const & s, double t_min, double & closest,
+                      std::size_t & best);
+  bool cylinders_avx512(ray_view const & r, cylinder_view const & c, double t_min,
+                        double & closest, std::size_t & best);
+
+  bool spheres_avx512_f32(ray_view const & r, sphere_view_f32 const & s, double t_min,
+                          double & closest, std::size_t & best);
+  bool cylinders_avx512_f32(ray_view const & r, cylinder_view_f32 const & c, double t_min,
+                            double & closest, std::size_t & best);
+
+}  // namespace render::soa
+
+#endif
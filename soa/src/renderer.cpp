@@ -0,0 +1,338 @@
+#include "renderer.hpp"
+
+#include "camera.hpp"
+#include "color.hpp"
+#include "framebuffer.hpp"
+#include "ray_batch.hpp"
+#include "sampling.hpp"
+#include "shading.hpp"
+
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <optional>
+#include <stdexcept>
+#include <utility>
+#include <vector>
+
+namespace render::soa {
+
+  namespace {
+
+    // Bucle caliente: sigue un camino de hasta max_depth rebotes y devuelve su color.
+    // Cada rebote toma sus números del flujo (key, id, depth), sin estado entre rebotes.
+    template <typename Probe>
+    vector trace_path(scene const & scn, Config const & cfg, ray r, std::uint64_t key,
+                      sample_id id, Probe & probe) {
+      constexpr double infinity = std::numeric_limits<double>::infinity();
+      vector throughput{1.0, 1.0, 1.0};
+      for (int depth = 0; depth < cfg.max_depth; ++depth) {
+        hit_record rec;
+        if (not scn.closest_hit(r, min_hit_distance, infinity, rec, probe)) {
+          probe.path_end(depth + 1);
+          return throughput.hadamard(background(cfg, r));
+        }
+        rng_engine gen(key, id, static_cast<std::uint32_t>(depth));
+        scatter_result sr;
+        if (not scatter(scn.material_at(rec.material), r, rec, gen, sr)) {
+          probe.path_end(depth + 1);
+          return {};
+        }
+        throughput = throughput.hadamard(sr.attenuation);
+        r          = sr.scattered;
+      }
+      probe.path_end(cfg.max_depth);
+      return {};
+    }
+
+    // Genera en batch los rayos primarios de las muestras [first, first + count) del píxel.
+    // Cada desplazamiento sale del flujo de su muestra, como en AoS.
+    void generate_rays(camera const & cam, int row, int col, std::size_t pixel,
+                       std::uint64_t key, int first, int count, ray_batch & batch) {
+      for (int s = 0; s < count; ++s) {
+        rng_engine ray_gen(key, {pixel, static_cast<std::uint32_t>(first + s)}, 0);
+        double const dx = ray_gen.uniform(-0.5, 0.5);
+        double const dy = ray_gen.uniform(-0.5, 0.5);
+        batch.set(static_cast<std::size_t>(s), cam.primary_ray(row, col, dx, dy));
+      }
+    }
+
+    // Muestrea los píxeles de una tesela: cada uno toma las muestras budget(pixel), se detiene
+    // antes si policy lo indica y store(pixel, est) recibe su estimación. Los rayos primarios
+    // se generan por rondas de policy.batch_size, las que se toman sin consultar done entre
+    // medias, así que con muestreo adaptativo no se generan rayos que no se van a trazar.
+    template <typename Probe, typename Budget, typename Store>
+    void render_tile(Config const & cfg, scene const & scn, camera const & cam, tile const & tl,
+                     int width, sample_policy const & policy, Probe & probe, Budget const & budget,
+                     Store const & store) {
+      std::uint64_t const ray_key      = rng_key(cfg.ray_rng_seed);
+      std::uint64_t const material_key = rng_key(cfg.material_rng_seed);
+
+      ray_batch batch;
+      batch.resize(static_cast<std::size_t>(policy.batch_size(0)));
+      for (int row = tl.row0; row < tl.row0 + tl.rows; ++row) {
+        for (int col = tl.col0; col < tl.col0 + tl.cols; ++col) {
+          auto const pixel = static_cast<std::size_t>(row) * static_cast<std::size_t>(width) +
+                             static_cast<std::size_t>(col);
+          sample_range const range = budget(pixel);
+          pixel_estimate est;
+          while (est.get_count() < range.count) {
+            int const taken = est.get_count();
+            int const take  = std::min(policy.batch_size(taken), range.count - taken);
+            generate_rays(cam, row, col, pixel, ray_key, range.first + taken, take, batch);
+            for (int s = 0; s < take; ++s) {
+              sample_id const id{pixel, static_cast<std::uint32_t>(range.first + taken + s)};
+              est.add(trace_path(scn, cfg, batch.get(static_cast<std::size_t>(s)), material_key,
+                                 id, probe));
+            }
+            if (policy.done(est)) {
+              break;
+            }
+          }
+          store(pixel, est);
+        }
+      }
+    }
+
+    // Índice en la imagen del píxel k-ésimo de la tesela, por filas
+    std::size_t tile_pixel(tile const & tl, int width, std::size_t k) {
+      auto const cols = static_cast<std::size_t>(tl.cols);
+      return (static_cast<std::size_t>(tl.row0) + k / cols) * static_cast<std::size_t>(width) +
+             static_cast<std::size_t>(tl.col0) + k % cols;
+    }
+
+    // Caminos por frente de onda como mucho: acota la memoria de una tesela con muchas muestras
+    constexpr std::size_t max_wave_paths = 4096;
+
+    // Memoria de trabajo de un frente de onda, reutilizada entre rondas y rebotes
+    struct wavefront {
+      path_batch paths;
+      path_batch next;
+      std::vector<hit_record> hits;
+      std::array<std::vector<std::uint32_t>, 3> queues;  // una por MaterialType
+      std::vector<sample_id> samples;                    // muestra de cada posición de la ronda
+      std::vector<vector> radiance;                      // color de cada posición de la ronda
+    };
+
+    // Sombrea la cola de caminos del material Type con su núcleo y pasa a wf.next los que
+    // siguen vivos
+    template <MaterialType Type, typename Probe>
+    void shade_queue(scene const & scn, std::uint64_t key, int depth, wavefront & wf,
+                     Probe & probe) {
+      for (std::uint32_t const i : wf.queues[static_cast<std::size_t>(Type)]) {
+        std::uint32_t const slot = wf.paths.slot[i];
+        hit_record const & rec   = wf.hits[i];
+        rng_engine gen(key, wf.samples[slot], static_cast<std::uint32_t>(depth));
+        scatter_result sr;
+        if (scatter_as<Type>(scn.material_at(rec.material), wf.paths.rays.get(i), rec, gen, sr)) {
+          wf.next.push(sr.scattered, wf.paths.throughput(i).hadamard(sr.attenuation), slot);
+        } else {
+          probe.path_end(depth + 1);
+        }
+      }
+    }
+
+    // Sigue todos los caminos de wf.paths rebote a rebote: intersección del lote completo,
+    // reparto de los impactos en colas por tipo de material, sombreado de cada cola y
+    // compactación de los supervivientes. Cada rebote usa el flujo de números de trace_path,
+    // así que cada camino da exactamente el mismo color que allí.
+    template <typename Probe>
+    void trace_wavefront(scene const & scn, Config const & cfg, std::uint64_t key,
+                         wavefront & wf, Probe & probe) {
+      constexpr double infinity = std::numeric_limits<double>::infinity();
+      for (int depth = 0; (depth < cfg.max_depth) and not wf.paths.empty(); ++depth) {
+        std::size_t const live = wf.paths.size();
+        wf.hits.resize(live);
+        for (auto & queue : wf.queues) {
+          queue.clear();
+        }
+        for (std::size_t i = 0; i < live; ++i) {
+          ray const r = wf.paths.rays.get(i);
+          if (scn.closest_hit(r, min_hit_distance, infinity, wf.hits[i], probe)) {
+            auto const type = static_cast<std::size_t>(scn.material_type(wf.hits[i].material));
+            wf.queues[type].push_back(static_cast<std::uint32_t>(i));
+          } else {
+            probe.path_end(depth + 1);
+            wf.radiance[wf.paths.slot[i]] = wf.paths.throughput(i).hadamard(background(cfg, r));
+          }
+        }
+
+        wf.next.clear();
+        shade_queue<MaterialType::Matte>(scn, key, depth, wf, probe);
+        shade_queue<MaterialType::Metal>(scn, key, depth, wf, probe);
+        shade_queue<MaterialType::Refractive>(scn, key, depth, wf, probe);
+        std::swap(wf.paths, wf.next);
+      }
+      for (std::size_t i = 0; i < wf.paths.size(); ++i) {
+        probe.path_end(cfg.max_depth);
+      }
+    }
+
+    // Como render_tile, por frentes de onda. Cada ronda toma de cada píxel pendiente las
+    // muestras que policy permite sin consultar done entre medias, las traza juntas y las suma
+    // en orden; después se consulta done como tras cada muestra en render_tile.
+    template <typename Probe, typename Budget, typename Store>
+    void render_tile_wavefront(Config const & cfg, scene const & scn, camera const & cam,
+                               tile const & tl, int width, sample_policy const & policy,
+                               Probe & probe, Budget const & budget, Store const & store) {
+      std::uint64_t const ray_key      = rng_key(cfg.ray_rng_seed);
+      std::uint64_t const material_key = rng_key(cfg.material_rng_seed);
+      auto const pixel_count           = static_cast<std::size_t>(tl.rows * tl.cols);
+      // Muestras por píxel y ronda que caben en un frente de onda
+      int const wave_share =
+          static_cast<int>(std::max<std::size_t>(1, max_wave_paths / pixel_count));
+
+      std::vector<sample_range> ranges(pixel_count);
+      std::vector<pixel_estimate> est(pixel_count);
+      std::vector<int> take(pixel_count);
+      for (std::size_t k = 0; k < pixel_count; ++k) {
+        ranges[k] = budget(tile_pixel(tl, width, k));
+      }
+
+      wavefront wf;
+      wf.paths.reserve(max_wave_paths);
+      wf.next.reserve(max_wave_paths);
+      bool pending = true;
+      while (pending) {
+        // Generación de los rayos primarios de la ronda
+        wf.paths.clear();
+        wf.samples.clear();
+        for (std::size_t k = 0; k < pixel_count; ++k) {
+          int const n = est[k].get_count();
+          take[k]     = (n < ranges[k].count) and not policy.done(est[k])
+                            ? std::min({policy.batch_size(n), ranges[k].count - n, wave_share})
+                            : 0;
+          int const row = tl.row0 + static_cast<int>(k) / tl.cols;
+          int const col = tl.col0 + static_cast<int>(k) % tl.cols;
+          for (int s = 0; s < take[k]; ++s) {
+            sample_id const id{tile_pixel(tl, width, k),
+                               static_cast<std::uint32_t>(ranges[k].first + n + s)};
+            rng_engine ray_gen(ray_key, id, 0);
+            double const dx = ray_gen.uniform(-0.5, 0.5);
+            double const dy = ray_gen.uniform(-0.5, 0.5);
+            wf.paths.push(cam.primary_ray(row, col, dx, dy), {1.0, 1.0, 1.0},
+                          static_cast<std::uint32_t>(wf.samples.size()));
+            wf.samples.push_back(id);
+          }
+        }
+        wf.radiance.assign(wf.samples.size(), vector{});
+
+        trace_wavefront(scn, cfg, material_key, wf, probe);
+
+        pending          = false;
+        std::size_t slot = 0;
+        for (std::size_t k = 0; k < pixel_count; ++k) {
+          for (int s = 0; s < take[k]; ++s) {
+            est[k].add(wf.radiance[slot++]);
+          }
+          pending = pending or ((take[k] > 0) and (est[k].get_count() < ranges[k].count) and
+                                not policy.done(est[k]));
+        }
+      }
+      for (std::size_t k = 0; k < pixel_count; ++k) {
+        store(tile_pixel(tl, width, k), est[k]);
+      }
+    }
+
+    // Reparte las teselas entre los hilos de pool; render(t, probe) procesa la tesela t. Con
+    // stats, la sonda cuenta rayos y se mide la ocupación de cada hilo.
+    template <typename Render>
+    void run_tiles(Config const & cfg, std::size_t tile_count, work_stealing_pool & pool,
+                   render_stats * stats, Render const & render) {
+      std::optional<tile_stats_sink> sink;
+      if (stats != nullptr) {
+        sink.emplace(*stats, cfg.max_depth, pool.size());
+      }
+      stopwatch const clock;
+      pool.run(tile_count, [&](std::size_t t) {
+        if (sink) {
+          stopwatch const tile_clock;
+          ray_stats probe(cfg.max_depth);
+          render(t, probe);
+          sink->add(probe, work_stealing_pool::current_worker(), tile_clock.seconds());
+        } else {
+          no_probe probe;
+          render(t, probe);
+        }
+      });
+      if (stats != nullptr) {
+        stats->render_seconds = clock.seconds();
+      }
+    }
+
+  }  // namespace
+
+  integrator parse_integrator(std::string const & name) {
+    if (name == "recursive") {
+      return integrator::recursive;
+    }
+    if (name == "wavefront") {
+      return integrator::wavefront;
+    }
+    throw std::runtime_error("Error: Invalid integrator: [" + name + "]");
+  }
+
+  framebuffer render_image(Config const & cfg, scene const & scn, int width, int height,
+                           work_stealing_pool & pool, row_sink const & on_rows,
+                           render_stats * stats, integrator mode) {
+    camera const cam(cfg, width, height);
+    std::vector<tile> const tiles = make_tiles(width, height);
+
+    framebuffer image(width, height);
+    tone_mapper const mapper(cfg.gamma);
+    band_tracker progress(tiles, image, mapper, on_rows);
+    sample_policy const policy(cfg);
+    auto const budget = [&](std::size_t) { return sample_range{0, cfg.samples_per_pixel}; };
+    auto const store  = [&](std::size_t pixel, pixel_estimate const & est) {
+      image.set(pixel, est.mean());
+    };
+    run_tiles(cfg, tiles.size(), pool, stats, [&](std::size_t t, auto & probe) {
+      if (mode == integrator::wavefront) {
+        render_tile_wavefront(cfg, scn, cam, tiles[t], width, policy, probe, budget, store);
+      } else {
+        render_tile(cfg, scn, cam, tiles[t], width, policy, probe, budget, store);
+      }
+      progress.tile_done(t);
+    });
+    return image;
+  }
+
+  void render_pass(Config const & cfg, scene const & scn, progress_state & state,
+                   work_stealing_pool & pool, render_stats * stats, integrator mode) {
+    camera const cam(cfg, state.width, state.height);
+    std::vector<tile> const tiles = make_tiles(state.width, state.height);
+
+    // Las muestras de la pasada siguen a las ya acumuladas: sin muestreo adaptativo, la imagen
+    // final es la misma con cualquier tamaño de pasada
+    int const samples = state.pass_samples;
+    sample_policy const policy(samples);
+    sample_policy const target(cfg);
+    auto const budget = [&](std::size_t pixel) {
+      pixel_estimate const & acc = state.pixels[pixel];
+      int const taken            = acc.get_count();
+      int const count =
+          target.converged(acc) ? 0 : std::min(samples, cfg.samples_per_pixel - taken);
+      return sample_range{taken, count};
+    };
+    auto const store = [&](std::size_t pixel, pixel_estimate const & est) {
+      state.pixels[pixel].merge(est);
+    };
+    render_stats pass_stats;
+    run_tiles(cfg, tiles.size(), pool, (stats != nullptr) ? &pass_stats : nullptr,
+              [&](std::size_t t, auto & probe) {
+                if (mode == integrator::wavefront) {
+                  render_tile_wavefront(cfg, scn, cam, tiles[t], state.width, policy, probe,
+                                        budget, store);
+                } else {
+                  render_tile(cfg, scn, cam, tiles[t], state.width, policy, probe, budget, store);
+                }
+              });
+    if (stats != nullptr) {
+      stats->merge(pass_stats);
+    }
+    ++state.passes_done;
+  }
+
+}  // namespace render::soa
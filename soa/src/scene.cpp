@@ -0,0 +1,395 @@
+#include "scene.hpp"
+
+#include <algorithm>
+#include <cstdint>
+#include <stdexcept>
+#include <string>
+#include <utility>
+
+namespace render::soa {
+
+  namespace {
+
+    // El parser ya resuelve el índice; se comprueba por si el objeto se construyó a mano
+    int material_index(std::vector<Material> const & materials, Object const & obj) {
+      if (obj.material_index >= materials.size()) {
+        throw std::runtime_error("Error: Invalid material index: [" +
+                                 std::to_string(obj.material_index) + "]");
+      }
+      return static_cast<int>(obj.material_index);
+    }
+
+    void store_material(material_set & set, std::size_t i, Material const & mat) {
+      surface const s = make_surface(mat);
+      set.type[i]     = s.type;
+      set.r[i]        = s.reflectance.get_x();
+      set.g[i]        = s.reflectance.get_y();
+      set.b[i]        = s.reflectance.get_z();
+      set.param[i]    = s.param;
+    }
+
+    void store_sphere(sphere_set & set, std::size_t i, Object const & obj, int material) {
+      set.cx[i]       = obj.params[0];
+      set.cy[i]       = obj.params[1];
+      set.cz[i]       = obj.params[2];
+      set.radius[i]   = obj.params[3];
+      set.material[i] = material;
+    }
+
+    void store_cylinder(cylinder_set & set, std::size_t i, Object const & obj, int material) {
+      vector const axis{obj.params[4], obj.params[5], obj.params[6]};
+      double const height = axis.magnitude();
+      vector const unit   = axis / height;
+      set.cx[i]           = obj.params[0];
+      set.cy[i]           = obj.params[1];
+      set.cz[i]           = obj.params[2];
+      set.ax[i]           = unit.get_x();
+      set.ay[i]           = unit.get_y();
+      set.az[i]           = unit.get_z();
+      set.radius[i]       = obj.params[3];
+      set.half_height[i]  = height / 2.0;
+      set.material[i]     = material;
+    }
+
+    // Posición actual de cada primitivo original de una jerarquía (identidad si no hay)
+    std::vector<std::uint32_t> positions(bvh const & tree, std::size_t count) {
+      std::vector<std::uint32_t> out(count);
+      std::vector<std::uint32_t> const & order = tree.get_order();
+      for (std::size_t pos = 0; pos < count; ++pos) {
+        out[tree.empty() ? pos : order[pos]] = static_cast<std::uint32_t>(pos);
+      }
+      return out;
+    }
+
+    template <typename T>
+    void permute(std::vector<T> & values, std::vector<std::uint32_t> const & order) {
+      std::vector<T> out;
+      out.reserve(values.size());
+      for (std::uint32_t const idx : order) {
+        out.push_back(values[idx]);
+      }
+      values = std::move(out);
+    }
+
+    std::vector<float> narrowed(std::vector<double> const & values) {
+      std::vector<float> out;
+      out.reserve(values.size());
+      for (double const v : values) {
+        out.push_back(static_cast<float>(v));
+      }
+      return out;
+    }
+
+    // Primitivos por hoja: el ancho de AVX-512, para que cada hoja sea un único bloque SIMD
+    // (8 double o 16 float)
+    constexpr std::size_t leaf_size     = 8;
+    constexpr std::size_t leaf_size_f32 = 16;
+
+  }  // namespace
+
+  void sphere_set::resize(std::size_t n) {
+    cx.resize(n);
+    cy.resize(n);
+    cz.resize(n);
+    radius.resize(n);
+    material.resize(n);
+  }
+
+  void cylinder_set::resize(std::size_t n) {
+    cx.resize(n);
+    cy.resize(n);
+    cz.resize(n);
+    ax.resize(n);
+    ay.resize(n);
+    az.resize(n);
+    radius.resize(n);
+    half_height.resize(n);
+    material.resize(n);
+  }
+
+  void material_set::resize(std::size_t n) {
+    type.resize(n);
+    r.resize(n);
+    g.resize(n);
+    b.resize(n);
+    param.resize(n);
+  }
+
+  void sphere_set::reorder(std::vector<std::uint32_t> const & order) {
+    permute(cx, order);
+    permute(cy, order);
+    permute(cz, order);
+    permute(radius, order);
+    permute(material, order);
+  }
+
+  void cylinder_set::reorder(std::vector<std::uint32_t> const & order) {
+    permute(cx, order);
+    permute(cy, order);
+    permute(cz, order);
+    permute(ax, order);
+    permute(ay, order);
+    permute(az, order);
+    permute(radius, order);
+    permute(half_height, order);
+    permute(material, order);
+  }
+
+  void sphere_set_f32::assign(sphere_set const & set) {
+    cx     = narrowed(set.cx);
+    cy     = narrowed(set.cy);
+    cz     = narrowed(set.cz);
+    radius = narrowed(set.radius);
+  }
+
+  void cylinder_set_f32::assign(cylinder_set const & set) {
+    cx          = narrowed(set.cx);
+    cy          = narrowed(set.cy);
+    cz          = narrowed(set.cz);
+    ax          = narrowed(set.ax);
+    ay          = narrowed(set.ay);
+    az          = narrowed(set.az);
+    radius      = narrowed(set.radius);
+    half_height = narrowed(set.half_height);
+  }
+
+  scene::scene(std::vector<Material> const & mats, std::vector<Object> const & objects,
+               simd_level level, accel_kind accel, precision mode)
+      : kernels{select_kernels(level)}, prec{mode} {
+    materials.resize(mats.size());
+    for (std::size_t m = 0; m < mats.size(); ++m) {
+      store_material(materials, m, mats[m]);
+    }
+    auto const sphere_count = static_cast<std::size_t>(
+        std::ranges::count(objects, ObjectType::Sphere, &Object::type));
+    spheres.resize(sphere_count);
+    cylinders.resize(objects.size() - sphere_count);
+    std::size_t s = 0;
+    std::size_t c = 0;
+    for (auto const & obj : objects) {
+      int const material = material_index(mats, obj);
+      if (obj.type == ObjectType::Sphere) {
+        store_sphere(spheres, s++, obj, material);
+      } else {
+        store_cylinder(cylinders, c++, obj, material);
+      }
+    }
+    if (accel == accel_kind::bvh) {
+      stopwatch const clock;
+      build_bvh();
+      bvh_seconds = clock.seconds();
+    } else {
+      narrow();
+    }
+  }
+
+  scene::scene(scene_cache const & cache, simd_level level, accel_kind accel, precision mode)
+      : scene(cache.get_materials(), cache.get_objects(), level, accel_kind::none) {
+    prec = mode;
+    if (accel != accel_kind::bvh) {
+      narrow();
+      return;
+    }
+    stopwatch const clock;
+    bvh const * const stored_spheres   = cache.find_hierarchy(cached_bvh::soa_spheres);
+    bvh const * const stored_cylinders = cache.find_hierarchy(cached_bvh::soa_cylinders);
+    // Una jerarquía vacía no se guarda: solo falta si no hay primitivos de ese tipo
+    bool const spheres_ok =
+        (stored_spheres != nullptr) ? (stored_spheres->get_order().size() == spheres.size())
+                                    : (spheres.size() == 0);
+    bool const cylinders_ok =
+        (stored_cylinders != nullptr)
+            ? (stored_cylinders->get_order().size() == cylinders.size())
+            : (cylinders.size() == 0);
+    if (spheres_ok and cylinders_ok) {
+      use_bvh((stored_spheres != nullptr) ? *stored_spheres : bvh{},
+              (stored_cylinders != nullptr) ? *stored_cylinders : bvh{});
+    } else {
+      build_bvh();
+    }
+    bvh_seconds = clock.seconds();
+  }
+
+  std::vector<aabb> scene::sphere_bounds() const {
+    std::vector<aabb> bounds;
+    bounds.reserve(spheres.size());
+    for (std::size_t i = 0; i < spheres.size(); ++i) {
+      bounds.push_back(render::sphere_bounds({spheres.cx[i], spheres.cy[i], spheres.cz[i]},
+                                             spheres.radius[i]));
+    }
+    return bounds;
+  }
+
+  std::vector<aabb> scene::cylinder_bounds() const {
+    std::vector<aabb> bounds;
+    bounds.reserve(cylinders.size());
+    for (std::size_t i = 0; i < cylinders.size(); ++i) {
+      bounds.push_back(
+          render::cylinder_bounds({cylinders.cx[i], cylinders.cy[i], cylinders.cz[i]},
+                                  cylinders.radius[i],
+                                  {cylinders.ax[i], cylinders.ay[i], cylinders.az[i]},
+                                  cylinders.half_height[i]));
+    }
+    return bounds;
+  }
+
+  void scene::build_bvh() {
+    std::size_t const leaf = (prec == precision::f32) ? leaf_size_f32 : leaf_size;
+    use_bvh(bvh(sphere_bounds(), leaf), bvh(cylinder_bounds(), leaf));
+  }
+
+  void scene::update(std::vector<Material> const & mats, std::vector<Object> const & objects,
+                     scene_diff const & diff) {
+    for (std::uint32_t const m : diff.materials) {
+      store_material(materials, m, mats[m]);
+    }
+    if (diff.objects.empty()) {
+      return;
+    }
+    // Índice de cada objeto dentro de su tipo y, con él, su posición en el array de ese tipo
+    std::vector<std::uint32_t> local(objects.size());
+    std::uint32_t s = 0;
+    std::uint32_t c = 0;
+    for (std::size_t i = 0; i < objects.size(); ++i) {
+      local[i] = (objects[i].type == ObjectType::Sphere) ? s++ : c++;
+    }
+    std::vector<std::uint32_t> const sphere_pos = positions(sphere_hierarchy, spheres.size());
+    std::vector<std::uint32_t> const cylinder_pos =
+        positions(cylinder_hierarchy, cylinders.size());
+    for (std::uint32_t const idx : diff.objects) {
+      Object const & obj = objects[idx];
+      int const material = material_index(mats, obj);
+      if (obj.type == ObjectType::Sphere) {
+        store_sphere(spheres, sphere_pos[local[idx]], obj, material);
+      } else {
+        store_cylinder(cylinders, cylinder_pos[local[idx]], obj, material);
+      }
+    }
+    stopwatch const clock;
+    if (not sphere_hierarchy.empty()) {
+      sphere_hierarchy.refit(sphere_bounds());
+    }
+    if (not cylinder_hierarchy.empty()) {
+      cylinder_hierarchy.refit(cylinder_bounds());
+    }
+    bvh_seconds = clock.seconds();
+    narrow();
+  }
+
+  void scene::use_bvh(bvh spheres_tree, bvh cylinders_tree) {
+    sphere_hierarchy   = std::move(spheres_tree);
+    cylinder_hierarchy = std::move(cylinders_tree);
+    spheres.reorder(sphere_hierarchy.get_order());
+    cylinders.reorder(cylinder_hierarchy.get_order());
+    narrow();
+  }
+
+  void scene::narrow() {
+    if (prec == precision::f32) {
+      spheres_f32.assign(spheres);
+      cylinders_f32.assign(cylinders);
+    }
+  }
+
+  bool scene::closest_hit(ray const & r, double t_min, double t_max, hit_record & rec) const {
+    no_probe probe;
+    return closest_hit(r, t_min, t_max, rec, probe);
+  }
+
+  template <typename Probe>
+  bool scene::closest_hit(ray const & r, double t_min, double t_max, hit_record & rec,
+                          Probe & probe) const {
+    ray_view const rv{r.origin.get_x(),    r.origin.get_y(),    r.origin.get_z(),
+                      r.direction.get_x(), r.direction.get_y(), r.direction.get_z()};
+    double closest            = t_max;
+    std::size_t best_sphere   = 0;
+    std::size_t best_cylinder = 0;
+    bool hit_spheres          = false;
+    bool hit_cylinders        = false;
+
+    auto const test_spheres = [&](std::size_t first, std::size_t count, std::size_t & local) {
+      probe.count_primitives(count);
+      return (prec == precision::f32)
+                 ? kernels.spheres_f32(rv, spheres_f32.view(first, count), t_min, closest, local)
+                 : kernels.spheres(rv, spheres.view(first, count), t_min, closest, local);
+    };
+    auto const test_cylinders = [&](std::size_t first, std::size_t count, std::size_t & local) {
+      probe.count_primitives(count);
+      return (prec == precision::f32)
+                 ? kernels.cylinders_f32(rv, cylinders_f32.view(first, count), t_min, closest,
+                                         local)
+                 : kernels.cylinders(rv, cylinders.view(first, count), t_min, closest, local);
+    };
+
+    if (sphere_hierarchy.empty()) {
+      hit_spheres = test_spheres(0, spheres.size(), best_sphere);
+    } else {
+      auto const leaf = [&](std::size_t first, std::size_t count) {
+        std::size_t local = 0;
+        if (test_spheres(first, count, local)) {
+          best_sphere = first + local;
+          hit_spheres = true;
+        }
+      };
+      sphere_hierarchy.traverse(r, t_min, closest, leaf, probe);
+    }
+    if (cylinder_hierarchy.empty()) {
+      hit_cylinders = test_cylinders(0, cylinders.size(), best_cylinder);
+    } else {
+      auto const leaf = [&](std::size_t first, std::size_t count) {
+        std::size_t local = 0;
+        if (test_cylinders(first, count, local)) {
+          best_cylinder = first + local;
+          hit_cylinders = true;
+        }
+      };
+      cylinder_hierarchy.traverse(r, t_min, closest, leaf, probe);
+    }
+    if (not(hit_spheres or hit_cylinders)) {
+      return false;
+    }
+
+    // Los cilindros se recorren después: si alguno mejora, es el más cercano. En f32 el t del
+    // primitivo elegido se recalcula en double; si en double no hay impacto (rayo rasante) se
+    // conserva el de float.
+    double t = 0.0;
+    if (hit_cylinders) {
+      std::size_t const i = best_cylinder;
+      vector const center{cylinders.cx[i], cylinders.cy[i], cylinders.cz[i]};
+      vector const axis{cylinders.ax[i], cylinders.ay[i], cylinders.az[i]};
+      if ((prec == precision::f32) and
+          hit_cylinder(r, center, cylinders.radius[i], axis, cylinders.half_height[i], t_min,
+                       t_max, t)) {
+        closest = t;
+      }
+      rec.point    = r.at(closest);
+      rec.normal   = cylinder_normal(rec.point, center, cylinders.radius[i], axis,
+                                     cylinders.half_height[i]);
+      rec.material = cylinders.material[i];
+    } else {
+      std::size_t const i = best_sphere;
+      vector const center{spheres.cx[i], spheres.cy[i], spheres.cz[i]};
+      if ((prec == precision::f32) and
+          hit_sphere(r, center, spheres.radius[i], t_min, t_max, t)) {
+        closest = t;
+      }
+      rec.point    = r.at(closest);
+      rec.normal   = sphere_normal(rec.point, center, spheres.radius[i]);
+      rec.material = spheres.material[i];
+    }
+    rec.t = closest;
+    return true;
+  }
+
+  surface scene::material_at(int idx) const {
+    auto const i = static_cast<std::size_t>(idx);
+    return {
+      materials.type[i], {materials.r[i], materials.g[i], materials.b[i]},
+       materials.param[i]
+    };
+  }
+
+  template bool scene::closest_hit(ray const &, double, double, hit_record &, no_probe &) const;
+  template bool scene::closest_hit(ray const &, double, double, hit_record &, ray_stats &) const;
+
+}  // namespace render::soa
@@ -0,0 +1,145 @@
+// Compilado con -mavx2: solo se ejecuta si detect_simd_level() lo permite
+#include "simd_impl.hpp"
+
+#include <immintrin.h>
+
+namespace render::soa {
+
+  namespace {
+
+    // 4 lanes de double; las máscaras son registros con todos los bits a 1 en las lanes activas
+    struct avx2 {
+      using scalar = double;
+      using reg    = __m256d;
+      using mask   = __m256d;
+
+      static constexpr std::size_t width = 4;
+
+      static reg set1(double v) { return _mm256_set1_pd(v); }
+
+      static reg load(double const * p, mask m) {
+        return _mm256_maskload_pd(p, _mm256_castpd_si256(m));
+      }
+
+      static void store(double * p, reg v) { _mm256_store_pd(p, v); }
+
+      static reg add(reg a, reg b) { return _mm256_add_pd(a, b); }
+
+      static reg sub(reg a, reg b) { return _mm256_sub_pd(a, b); }
+
+      static reg mul(reg a, reg b) { return _mm256_mul_pd(a, b); }
+
+      static reg div(reg a, reg b) { return _mm256_div_pd(a, b); }
+
+      static reg sqrt(reg a) { return _mm256_sqrt_pd(a); }
+
+      static reg neg(reg a) { return _mm256_xor_pd(a, _mm256_set1_pd(-0.0)); }
+
+      static reg abs(reg a) { return _mm256_andnot_pd(_mm256_set1_pd(-0.0), a); }
+
+      static mask ge(reg a, reg b) { return _mm256_cmp_pd(a, b, _CMP_GE_OQ); }
+
+      static mask le(reg a, reg b) { return _mm256_cmp_pd(a, b, _CMP_LE_OQ); }
+
+      static mask gt(reg a, reg b) { return _mm256_cmp_pd(a, b, _CMP_GT_OQ); }
+
+      static mask land(mask a, mask b) { return _mm256_and_pd(a, b); }
+
+      static mask lor(mask a, mask b) { return _mm256_or_pd(a, b); }
+
+      // a and not b
+      static mask landnot(mask a, mask b) { return _mm256_andnot_pd(b, a); }
+
+      static reg select(mask m, reg if_true, reg if_false) {
+        return _mm256_blendv_pd(if_false, if_true, m);
+      }
+
+      static unsigned bits(mask m) { return static_cast<unsigned>(_mm256_movemask_pd(m)); }
+
+      // Máscara con las min(n, width) primeras lanes activas
+      static mask lanes(std::size_t n) {
+        auto const k = static_cast<long long>((n < width) ? n : width);
+        return _mm256_castsi256_pd(
+            _mm256_cmpgt_epi64(_mm256_set1_epi64x(k), _mm256_setr_epi64x(0, 1, 2, 3)));
+      }
+    };
+
+    // 8 lanes de float, con las mismas convenciones
+    struct avx2_f32 {
+      using scalar = float;
+      using reg    = __m256;
+      using mask   = __m256;
+
+      static constexpr std::size_t width = 8;
+
+      static reg set1(double v) { return _mm256_set1_ps(static_cast<float>(v)); }
+
+      static reg load(float const * p, mask m) {
+        return _mm256_maskload_ps(p, _mm256_castps_si256(m));
+      }
+
+      static void store(float * p, reg v) { _mm256_store_ps(p, v); }
+
+      static reg add(reg a, reg b) { return _mm256_add_ps(a, b); }
+
+      static reg sub(reg a, reg b) { return _mm256_sub_ps(a, b); }
+
+      static reg mul(reg a, reg b) { return _mm256_mul_ps(a, b); }
+
+      static reg div(reg a, reg b) { return _mm256_div_ps(a, b); }
+
+      static reg sqrt(reg a) { return _mm256_sqrt_ps(a); }
+
+      static reg neg(reg a) { return _mm256_xor_ps(a, _mm256_set1_ps(-0.0F)); }
+
+      static reg abs(reg a) { return _mm256_andnot_ps(_mm256_set1_ps(-0.0F), a); }
+
+      static mask ge(reg a, reg b) { return _mm256_cmp_ps(a, b, _CMP_GE_OQ); }
+
+      static mask le(reg a, reg b) { return _mm256_cmp_ps(a, b, _CMP_LE_OQ); }
+
+      static mask gt(reg a, reg b) { return _mm256_cmp_ps(a, b, _CMP_GT_OQ); }
+
+      static mask land(mask a, mask b) { return _mm256_and_ps(a, b); }
+
+      static mask lor(mask a, mask b) { return _mm256_or_ps(a, b); }
+
+      // a and not b
+      static mask landnot(mask a, mask b) { return _mm256_andnot_ps(b, a); }
+
+      static reg select(mask m, reg if_true, reg if_false) {
+        return _mm256_blendv_ps(if_false, if_true, m);
+      }
+
+      static unsigned bits(mask m) { return static_cast<unsigned>(_mm256_movemask_ps(m)); }
+
+      static mask lanes(std::size_t n) {
+        auto const k = static_cast<int>((n < width) ? n : width);
+        return _mm256_castsi256_ps(
+            _mm256_cmpgt_epi32(_mm256_set1_epi32(k), _mm256_setr_epi32(0, 1, 2, 3, 4, 5, 6, 7)));
+      }
+    };
+
+  }  // namespace
+
+  bool spheres_avx2(ray_view const & r, sphere_view const & s, double t_min, double & closest,
+                    std::size_t & best) {
+    return simd::spheres<avx2>(r, s, t_min, closest, best);
+  }
+
+  bool cylinders_avx2(ray_view const & r, cylinder_view const & c, double t_min, double & closest,
+                      std::size_t & best) {
+    return simd::cylinders<avx2>(r, c, t_min, closest, best);
+  }
+
+  bool spheres_avx2_f32(ray_view const & r, sphere_view_f32 const & s, double t_min,
+                        double & closest, std::size_t & best) {
+    return simd::spheres<avx2_f32>(r, s, t_min, closest, best);
+  }
+
+  bool cylinders_avx2_f32(ray_view const & r, cylinder_view_f32 const & c, double t_min,
+                          double & closest, std::size_t & best) {
+    return simd::cylinders<avx2_f32>(r, c, t_min, closest, best);
+  }
+
+}  // namespace render::soa
@@ -0,0 +1,139 @@
+// Compilado con -mavx512f: solo se ejecuta si detect_simd_level() lo permite
+#include "simd_impl.hpp"
+
+#include <immintrin.h>
+
+namespace render::soa {
+
+  namespace {
+
+    // 8 lanes de double con registros de máscara de 8 bits
+    struct avx512 {
+      using scalar = double;
+      using reg    = __m512d;
+      using mask   = __mmask8;
+
+      static constexpr std::size_t width = 8;
+
+      static reg set1(double v) { return _mm512_set1_pd(v); }
+
+      static reg load(double const * p, mask m) { return _mm512_maskz_loadu_pd(m, p); }
+
+      static void store(double * p, reg v) { _mm512_store_pd(p, v); }
+
+      static reg add(reg a, reg b) { return _mm512_add_pd(a, b); }
+
+      static reg sub(reg a, reg b) { return _mm512_sub_pd(a, b); }
+
+      static reg mul(reg a, reg b) { return _mm512_mul_pd(a, b); }
+
+      static reg div(reg a, reg b) { return _mm512_div_pd(a, b); }
+
+      // Variante con máscara: _mm512_sqrt_pd dispara un falso -Wmaybe-uninitialized en GCC 12
+      static reg sqrt(reg a) { return _mm512_maskz_sqrt_pd(0xFF, a); }
+
+      // Multiplicar por -1 es exacto (también para ceros con signo) y no requiere AVX-512DQ
+      static reg neg(reg a) { return _mm512_mul_pd(a, _mm512_set1_pd(-1.0)); }
+
+      static reg abs(reg a) { return _mm512_abs_pd(a); }
+
+      static mask ge(reg a, reg b) { return _mm512_cmp_pd_mask(a, b, _CMP_GE_OQ); }
+
+      static mask le(reg a, reg b) { return _mm512_cmp_pd_mask(a, b, _CMP_LE_OQ); }
+
+      static mask gt(reg a, reg b) { return _mm512_cmp_pd_mask(a, b, _CMP_GT_OQ); }
+
+      static mask land(mask a, mask b) { return static_cast<mask>(a & b); }
+
+      static mask lor(mask a, mask b) { return static_cast<mask>(a | b); }
+
+      // a and not b
+      static mask landnot(mask a, mask b) { return static_cast<mask>(a & ~b); }
+
+      static reg select(mask m, reg if_true, reg if_false) {
+        return _mm512_mask_blend_pd(m, if_false, if_true);
+      }
+
+      static unsigned bits(mask m) { return static_cast<unsigned>(m); }
+
+      // Máscara con las min(n, width) primeras lanes activas
+      static mask lanes(std::size_t n) {
+        return (n >= width) ? static_cast<mask>(0xFF) : static_cast<mask>((1U << n) - 1U);
+      }
+    };
+
+    // 16 lanes de float con registros de máscara de 16 bits
+    struct avx512_f32 {
+      using scalar = float;
+      using reg    = __m512;
+      using mask   = __mmask16;
+
+      static constexpr std::size_t width = 16;
+
+      static reg set1(double v) { return _mm512_set1_ps(static_cast<float>(v)); }
+
+      static reg load(float const * p, mask m) { return _mm512_maskz_loadu_ps(m, p); }
+
+      static void store(float * p, reg v) { _mm512_store_ps(p, v); }
+
+      static reg add(reg a, reg b) { return _mm512_add_ps(a, b); }
+
+      static reg sub(reg a, reg b) { return _mm512_sub_ps(a, b); }
+
+      static reg mul(reg a, reg b) { return _mm512_mul_ps(a, b); }
+
+      static reg div(reg a, reg b) { return _mm512_div_ps(a, b); }
+
+      static reg sqrt(reg a) { return _mm512_maskz_sqrt_ps(0xFFFF, a); }
+
+      static reg neg(reg a) { return _mm512_mul_ps(a, _mm512_set1_ps(-1.0F)); }
+
+      static reg abs(reg a) { return _mm512_abs_ps(a); }
+
+      static mask ge(reg a, reg b) { return _mm512_cmp_ps_mask(a, b, _CMP_GE_OQ); }
+
+      static mask le(reg a, reg b) { return _mm512_cmp_ps_mask(a, b, _CMP_LE_OQ); }
+
+      static mask gt(reg a, reg b) { return _mm512_cmp_ps_mask(a, b, _CMP_GT_OQ); }
+
+      static mask land(mask a, mask b) { return static_cast<mask>(a & b); }
+
+      static mask lor(mask a, mask b) { return static_cast<mask>(a | b); }
+
+      // a and not b
+      static mask landnot(mask a, mask b) { return static_cast<mask>(a & ~b); }
+
+      static reg select(mask m, reg if_true, reg if_false) {
+        return _mm512_mask_blend_ps(m, if_false, if_true);
+      }
+
+      static unsigned bits(mask m) { return static_cast<unsigned>(m); }
+
+      static mask lanes(std::size_t n) {
+        return (n >= width) ? static_cast<mask>(0xFFFF) : static_cast<mask>((1U << n) - 1U);
+      }
+    };
+
+  }  // namespace
+
+  bool spheres_avx512(ray_view const & r, sphere_view const & s, double t_min, double & closest,
+                      std::size_t & best) {
+    return simd::spheres<avx512>(r, s, t_min, closest, best);
+  }
+
+  bool cylinders_avx512(ray_view const & r, cylinder_view const & c, double t_min,
+                        double & closest, std::size_t & best) {
+    return simd::cylinders<avx512>(r, c, t_min, closest, best);
+  }
+
+  bool spheres_avx512_f32(ray_view const & r, sphere_view_f32 const & s, double t_min,
+                          double & closest, std::size_t & best) {
+    return simd::spheres<avx512_f32>(r, s, t_min, closest, best);
+  }
+
+  bool cylinders_avx512_f32(ray_view const & r, cylinder_view_f32 const & c, double t_min,
+                            double & closest, std::size_t & best) {
+    return simd::cylinders<avx512_f32>(r, c, t_min, closest, best);
+  }
+
+}  // namespace render::soa
@@ -0,0 +1,190 @@
+#include "simd_kernels.hpp"
+
+#include "geometry.hpp"
+#include "ray.hpp"
+#include "simd_impl.hpp"
+
+#include <cmath>
+#include <stdexcept>
+
+namespace render::soa {
+
+  namespace {
+
+    ray to_ray(ray_view const & r) {
+      return {
+        {r.ox, r.oy, r.oz},
+        {r.dx, r.dy, r.dz}
+      };
+    }
+
+    // Una sola lane de float: la versión escalar de los núcleos en precisión simple, con la
+    // misma aritmética que las variantes SIMD
+    struct scalar_f32 {
+      using scalar = float;
+      using reg    = float;
+      using mask   = bool;
+
+      static constexpr std::size_t width = 1;
+
+      static reg set1(double v) { return static_cast<float>(v); }
+
+      static reg load(float const * p, mask m) { return m ? *p : 0.0F; }
+
+      static void store(float * p, reg v) { *p = v; }
+
+      static reg add(reg a, reg b) { return a + b; }
+
+      static reg sub(reg a, reg b) { return a - b; }
+
+      static reg mul(reg a, reg b) { return a * b; }
+
+      static reg div(reg a, reg b) { return a / b; }
+
+      static reg sqrt(reg a) { return std::sqrt(a); }
+
+      static reg neg(reg a) { return -a; }
+
+      static reg abs(reg a) { return std::abs(a); }
+
+      static mask ge(reg a, reg b) { return a >= b; }
+
+      static mask le(reg a, reg b) { return a <= b; }
+
+      static mask gt(reg a, reg b) { return a > b; }
+
+      static mask land(mask a, mask b) { return a and b; }
+
+      static mask lor(mask a, mask b) { return a or b; }
+
+      // a and not b
+      static mask landnot(mask a, mask b) { return a and not b; }
+
+      static reg select(mask m, reg if_true, reg if_false) { return m ? if_true : if_false; }
+
+      static unsigned bits(mask m) { return m ? 1U : 0U; }
+
+      static mask lanes(std::size_t n) { return n > 0; }
+    };
+
+  }  // namespace
+
+  bool spheres_scalar(ray_view const & r, sphere_view const & s, double t_min, double & closest,
+                      std::size_t & best) {
+    ray const rr  = to_ray(r);
+    bool improved = false;
+    for (std::size_t i = 0; i < s.count; ++i) {
+      double t = 0.0;
+      if (hit_sphere(rr, {s.cx[i], s.cy[i], s.cz[i]}, s.radius[i], t_min, closest, t)) {
+        closest  = t;
+        best     = i;
+        improved = true;
+      }
+    }
+    return improved;
+  }
+
+  bool cylinders_scalar(ray_view const & r, cylinder_view const & c, double t_min,
+                        double & closest, std::size_t & best) {
+    ray const rr  = to_ray(r);
+    bool improved = false;
+    for (std::size_t i = 0; i < c.count; ++i) {
+      double t = 0.0;
+      if (hit_cylinder(rr, {c.cx[i], c.cy[i], c.cz[i]}, c.radius[i], {c.ax[i], c.ay[i], c.az[i]},
+                       c.half_height[i], t_min, closest, t)) {
+        closest  = t;
+        best     = i;
+        improved = true;
+      }
+    }
+    return improved;
+  }
+
+  bool spheres_scalar_f32(ray_view const & r, sphere_view_f32 const & s, double t_min,
+                          double & closest, std::size_t & best) {
+    return simd::spheres<scalar_f32>(r, s, t_min, closest, best);
+  }
+
+  bool cylinders_scalar_f32(ray_view const & r, cylinder_view_f32 const & c, double t_min,
+                            double & closest, std::size_t & best) {
+    return simd::cylinders<scalar_f32>(r, c, t_min, closest, best);
+  }
+
+  simd_level detect_simd_level() {
+#if defined(RENDER_SIMD_X86)
+    __builtin_cpu_init();
+    if (__builtin_cpu_supports("avx512f")) {
+      return simd_level::avx512;
+    }
+    if (__builtin_cpu_supports("avx2")) {
+      return simd_level::avx2;
+    }
+#endif
+    return simd_level::scalar;
+  }
+
+  intersect_kernels select_kernels(simd_level requested) {
+    simd_level const supported = detect_simd_level();
+    simd_level level           = requested;
+    if ((requested == simd_level::automatic) or (requested > supported)) {
+      level = supported;
+    }
+    switch (level) {
+#if defined(RENDER_SIMD_X86)
+      case simd_level::avx512:
+        return {level, spheres_avx512, cylinders_avx512, spheres_avx512_f32,
+                cylinders_avx512_f32};
+      case simd_level::avx2:
+        return {level, spheres_avx2, cylinders_avx2, spheres_avx2_f32, cylinders_avx2_f32};
+#endif
+      default:
+        return {simd_level::scalar, spheres_scalar, cylinders_scalar, spheres_scalar_f32,
+                cylinders_scalar_f32};
+    }
+  }
+
+  simd_level parse_simd_level(std::string const & name) {
+    if (name == "auto") {
+      return simd_level::automatic;
+    }
+    if (name == "scalar") {
+      return simd_level::scalar;
+    }
+    if (name == "avx2") {
+      return simd_level::avx2;
+    }
+    if (name == "avx512") {
+      return simd_level::avx512;
+    }
+    throw std::runtime_error("Error: Invalid SIMD level: [" + name + "]");
+  }
+
+  char const * simd_level_name(simd_level level) {
+    switch (level) {
+      case simd_level::automatic:
+        return "auto";
+      case simd_level::scalar:
+        return "scalar";
+      case simd_level::avx2:
+        return "avx2";
+      case simd_level::avx512:
+        return "avx512";
+    }
+    return "scalar";
+  }
+
+  precision parse_precision(std::string const & name) {
+    if (name == "double") {
+      return precision::f64;
+    }
+    if (name == "float") {
+      return precision::f32;
+    }
+    throw std::runtime_error("Error: Invalid precision: [" + name + "]");
+  }
+
+  char const * precision_name(precision prec) {
+    return (prec == precision::f32) ? "float" : "double";
+  }
+
+}  // namespace render::soa
@@ -0,0 +1,269 @@
+#include <gtest/gtest.h>
+
+#include "renderer.hpp"
+#include "scene.hpp"
+
+#include <array>
+#include <filesystem>
+#include <limits>
+#include <random>
+#include <stdexcept>
+
+namespace {
+
+    render::aos::scene make_scene(render::accel_kind accel = render::accel_kind::bvh) {
+        std::vector<Material> mats = {{"m", MaterialType::Matte, {0.5, 0.5, 0.5}}};
+        std::vector<Object> objs   = {
+            {ObjectType::Sphere, 0, {0.0, 0.0, 10.0, 1.0}, 0},
+            {ObjectType::Sphere, 0, {0.0, 0.0, 5.0, 1.0}, 0},
+            {ObjectType::Cylinder, 0, {5.0, 0.0, 5.0, 1.0, 0.0, 2.0, 0.0}, 0},
+        };
+        return render::aos::scene(mats, objs, accel);
+    }
+
+}  // namespace
+
+TEST(test_scene, closest_hit_picks_nearest) {
+    auto scn = make_scene();
+    render::ray r{{0.0, 0.0, 0.0}, {0.0, 0.0, 1.0}};
+    render::hit_record rec;
+    ASSERT_TRUE(scn.closest_hit(r, 1e-3, std::numeric_limits<double>::infinity(), rec));
+    EXPECT_DOUBLE_EQ(rec.t, 4.0);
+    EXPECT_DOUBLE_EQ(rec.normal.get_z(), -1.0);
+    EXPECT_EQ(rec.material, 0);
+}
+
+TEST(test_scene, closest_hit_cylinder) {
+    auto scn = make_scene();
+    render::ray r{{5.0, 0.0, 0.0}, {0.0, 0.0, 1.0}};
+    render::hit_record rec;
+    ASSERT_TRUE(scn.closest_hit(r, 1e-3, std::numeric_limits<double>::infinity(), rec));
+    EXPECT_DOUBLE_EQ(rec.t, 4.0);
+}
+
+TEST(test_scene, closest_hit_miss) {
+    auto scn = make_scene();
+    render::ray r{{0.0, 0.0, 0.0}, {0.0, 1.0, 0.0}};
+    render::hit_record rec;
+    EXPECT_FALSE(scn.closest_hit(r, 1e-3, std::numeric_limits<double>::infinity(), rec));
+}
+
+TEST(test_scene, bvh_matches_brute_force) {
+    std::mt19937_64 gen(3);
+    std::uniform_real_distribution<double> pos(-20.0, 20.0);
+    std::vector<Material> mats = {{"m", MaterialType::Matte, {0.5, 0.5, 0.5}}};
+    std::vector<Object> objs;
+    for (int i = 0; i < 300; ++i) {
+        double const x = pos(gen), y = pos(gen), z = pos(gen);
+        if (i % 3 == 0) {
+            objs.push_back({ObjectType::Cylinder, 0, {x, y, z, 0.5, 1.0, 2.0, 0.5}, 0});
+        } else {
+            objs.push_back({ObjectType::Sphere, 0, {x, y, z, 1.0}, 0});
+        }
+    }
+    render::aos::scene const brute(mats, objs, render::accel_kind::none);
+    render::aos::scene const tree(mats, objs, render::accel_kind::bvh);
+    double const inf = std::numeric_limits<double>::infinity();
+    for (int i = 0; i < 2'000; ++i) {
+        render::vector const dir{pos(gen), pos(gen), pos(gen)};
+        render::ray const r{{0.0, 0.0, 0.0}, dir.normalized()};
+        render::hit_record a, b;
+        bool const hit_a = brute.closest_hit(r, 1e-3, inf, a);
+        ASSERT_EQ(hit_a, tree.closest_hit(r, 1e-3, inf, b));
+        if (hit_a) {
+            EXPECT_EQ(a.t, b.t);
+        }
+    }
+}
+
+TEST(test_scene, uses_material_index) {
+    std::vector<Material> mats = {
+        {"a", MaterialType::Matte, {0.5, 0.5, 0.5}},
+        {"b", MaterialType::Refractive, {1.5}},
+    };
+    std::vector<Object> objs = {{ObjectType::Sphere, 1, {0.0, 0.0, 5.0, 1.0}, 0}};
+    render::aos::scene const scn(mats, objs);
+    render::ray const r{{0.0, 0.0, 0.0}, {0.0, 0.0, 1.0}};
+    render::hit_record rec;
+    ASSERT_TRUE(scn.closest_hit(r, 1e-3, std::numeric_limits<double>::infinity(), rec));
+    EXPECT_EQ(rec.material, 1);
+
+    objs[0].material_index = 2;
+    EXPECT_THROW(render::aos::scene(mats, objs), std::runtime_error);
+}
+
+TEST(test_scene, loads_compiled_scene) {
+    std::vector<Material> mats = {{"m", MaterialType::Matte, {0.5, 0.5, 0.5}}};
+    std::vector<Object> objs;
+    for (std::uint32_t i = 0; i < 50; ++i) {
+        double const x = static_cast<double>((i * 37) % 50);
+        objs.push_back({ObjectType::Sphere, 0, {x, 0.0, 10.0, 0.5}, i});
+    }
+    render::aos::scene const text(mats, objs);
+    std::string const path = (std::filesystem::temp_directory_path() / "utaos.rsc").string();
+    std::array const hierarchies = {
+        render::cache_hierarchy{render::cached_bvh::aos, &text.get_bvh()}
+    };
+    render::write_scene_cache(path, mats, objs, hierarchies);
+
+    render::aos::scene const compiled(render::scene_cache{path});
+    ASSERT_EQ(compiled.get_bvh().get_order(), text.get_bvh().get_order());
+    ASSERT_EQ(compiled.get_spheres().size(), text.get_spheres().size());
+    for (std::size_t i = 0; i < text.get_spheres().size(); ++i) {
+        EXPECT_EQ(compiled.get_spheres()[i].center.get_x(), text.get_spheres()[i].center.get_x());
+    }
+}
+
+TEST(test_scene, counts_rays) {
+    std::vector<Material> mats = {{"m", MaterialType::Matte, {0.5, 0.5, 0.5}}};
+    std::vector<Object> objs   = {{ObjectType::Sphere, 0, {0.0, 0.0, 0.0, 1.0}, 0}};
+    render::aos::scene const scn(mats, objs);
+    Config cfg;
+    cfg.image_width       = 16;
+    cfg.samples_per_pixel = 2;
+    cfg.max_depth         = 3;
+    render::work_stealing_pool pool(2);
+    render::render_stats stats;
+    auto const plain   = render::aos::render_image(cfg, scn, 16, 9, pool);
+    auto const counted = render::aos::render_image(cfg, scn, 16, 9, pool, {}, &stats);
+
+    // Contar no cambia la imagen
+    EXPECT_EQ(plain, counted);
+    EXPECT_EQ(stats.rays.primary, 16U * 9U * 2U);
+    std::uint64_t paths    = 0;
+    std::uint64_t segments = 0;
+    for (std::size_t k = 0; k < stats.rays.path_lengths.size(); ++k) {
+        paths += stats.rays.path_lengths[k];
+        segments += k * stats.rays.path_lengths[k];
+    }
+    EXPECT_EQ(paths, stats.rays.primary);
+    EXPECT_EQ(segments, stats.rays.primary + stats.rays.secondary);
+    EXPECT_GT(stats.rays.box_tests, 0U);
+    EXPECT_EQ(stats.busy_seconds.size(), 2U);
+}
+
+TEST(test_scene, adaptive_sampling_stops_early) {
+    std::vector<Material> mats = {{"m", MaterialType::Matte, {0.5, 0.5, 0.5}}};
+    std::vector<Object> objs   = {{ObjectType::Sphere, 0, {0.0, 0.0, 0.0, 1.0}, 0}};
+    render::aos::scene const scn(mats, objs);
+    Config cfg;
+    cfg.image_width        = 32;
+    cfg.samples_per_pixel  = 32;
+    cfg.adaptive_threshold = 0.01;
+    render::work_stealing_pool pool(2);
+    Config fixed_cfg             = cfg;
+    fixed_cfg.adaptive_threshold = 0.0;
+    render::render_stats fixed;
+    render::aos::render_image(fixed_cfg, scn, 32, 18, pool, {}, &fixed);
+    render::render_stats adaptive;
+    auto const image = render::aos::render_image(cfg, scn, 32, 18, pool, {}, &adaptive);
+
+    // El cielo converge en la primera ronda; la esfera sigue hasta el máximo
+    EXPECT_LT(adaptive.rays.primary, fixed.rays.primary / 2);
+    EXPECT_GT(adaptive.rays.primary, 32U * 18U * 8U);
+
+    // Determinista e independiente del número de hilos
+    render::work_stealing_pool single(1);
+    EXPECT_EQ(render::aos::render_image(cfg, scn, 32, 18, single), image);
+}
+
+TEST(test_scene, single_pass_matches_render_image) {
+    std::vector<Material> mats = {{"m", MaterialType::Matte, {0.5, 0.5, 0.5}}};
+    std::vector<Object> objs   = {{ObjectType::Sphere, 0, {0.0, 0.0, 0.0, 1.0}, 0}};
+    render::aos::scene const scn(mats, objs);
+    Config cfg;
+    cfg.samples_per_pixel = 3;
+    render::work_stealing_pool pool(2);
+
+    // Una sola pasada con todas las muestras usa los mismos flujos que el render directo
+    render::progress_state state(16, 9, 3, 0);
+    render::aos::render_pass(cfg, scn, state, pool);
+    EXPECT_EQ(state.passes_done, 1);
+    auto const image = render::aos::render_image(cfg, scn, 16, 9, pool);
+    EXPECT_EQ(state.image(), image);
+
+    // Con pasadas de una muestra, cada una toma la siguiente muestra de cada píxel
+    render::progress_state steps(16, 9, 1, 0);
+    for (int pass = 0; pass < 3; ++pass) {
+        render::aos::render_pass(cfg, scn, steps, pool);
+    }
+    EXPECT_EQ(steps.image(), image);
+
+    // Las pasadas siguientes no añaden muestras por encima de samples_per_pixel
+    render::aos::render_pass(cfg, scn, state, pool);
+    EXPECT_EQ(state.pixels[0].get_count(), 3);
+}
+
+TEST(test_scene, mixed_leaves_pick_nearest_type) {
+    std::vector<Material> mats = {
+        {"a", MaterialType::Matte, {0.5, 0.5, 0.5}},
+        {"b", MaterialType::Metal, {0.5, 0.5, 0.5, 0.0}},
+    };
+    // Esferas y cilindros alternados a lo largo del eje z: las hojas mezclan los dos tipos
+    std::vector<Object> objs;
+    for (std::uint32_t i = 0; i < 40; ++i) {
+        double const z = 3.0 + static_cast<double>((i * 17) % 40);
+        if (i % 2 == 0) {
+            objs.push_back({ObjectType::Sphere, 0, {0.0, 0.0, z, 0.4}, i});
+        } else {
+            objs.push_back({ObjectType::Cylinder, 1, {0.0, 0.0, z, 0.4, 0.0, 1.0, 0.0}, i});
+        }
+    }
+    render::aos::scene const with_bvh(mats, objs);
+    render::aos::scene const brute(mats, objs, render::accel_kind::none);
+    for (int k = 0; k < 20; ++k) {
+        double const x = -0.3 + 0.03 * k;
+        render::ray const r{{x, 0.1, 2.5 + k}, {0.0, 0.0, 1.0}};
+        render::hit_record a;
+        render::hit_record b;
+        ASSERT_TRUE(with_bvh.closest_hit(r, 1e-3, std::numeric_limits<double>::infinity(), a));
+        ASSERT_TRUE(brute.closest_hit(r, 1e-3, std::numeric_limits<double>::infinity(), b));
+        EXPECT_EQ(a.t, b.t);
+        EXPECT_EQ(a.material, b.material);
+        EXPECT_EQ(a.normal.get_z(), b.normal.get_z());
+    }
+}
+
+TEST(test_scene, update_matches_rebuild) {
+    std::mt19937_64 gen(5);
+    std::uniform_real_distribution<double> pos(-20.0, 20.0);
+    std::vector<Material> mats = {{"m", MaterialType::Matte, {0.5, 0.5, 0.5}},
+                                  {"n", MaterialType::Metal, {0.9, 0.9, 0.9, 0.0}}};
+    std::vector<Object> objs;
+    for (int i = 0; i < 300; ++i) {
+        double const x = pos(gen), y = pos(gen), z = pos(gen);
+        if (i % 3 == 0) {
+            objs.push_back({ObjectType::Cylinder, 0, {x, y, z, 0.5, 1.0, 2.0, 0.5}, 0});
+        } else {
+            objs.push_back({ObjectType::Sphere, 0, {x, y, z, 1.0}, 0});
+        }
+    }
+    render::aos::scene scn(mats, objs);
+
+    auto new_mats         = mats;
+    auto new_objs         = objs;
+    new_mats[0].params[1] = 0.1;
+    for (std::size_t i = 0; i < new_objs.size(); i += 13) {
+        new_objs[i].params[0] += 3.0;
+        new_objs[i].params[3] *= 2.0;
+        new_objs[i].material_index = 1;
+    }
+    auto const diff = render::diff_scenes(mats, objs, new_mats, new_objs);
+    ASSERT_TRUE(diff.refittable(new_objs.size()));
+    scn.update(new_mats, new_objs, diff);
+
+    render::aos::scene const fresh(new_mats, new_objs, render::accel_kind::none);
+    EXPECT_DOUBLE_EQ(scn.material_at(0).reflectance.get_y(), 0.1);
+    double const inf = std::numeric_limits<double>::infinity();
+    for (int i = 0; i < 2'000; ++i) {
+        render::vector const dir{pos(gen), pos(gen), pos(gen)};
+        render::ray const r{{0.0, 0.0, 0.0}, dir.normalized()};
+        render::hit_record a, b;
+        bool const hit_a = fresh.closest_hit(r, 1e-3, inf, a);
+        ASSERT_EQ(hit_a, scn.closest_hit(r, 1e-3, inf, b));
+        if (hit_a) {
+            EXPECT_EQ(a.t, b.t);
+            EXPECT_EQ(a.material, b.material);
+        }
+    }
+}
@@ -0,0 +1,93 @@
+#include <gtest/gtest.h>
+
+#include "animation.hpp"
+
+#include <cmath>
+#include <filesystem>
+#include <fstream>
+#include <stdexcept>
+#include <string>
+
+namespace {
+
+    std::string write_temp(std::string const & name, std::string const & text) {
+        auto const path = std::filesystem::temp_directory_path() / name;
+        std::ofstream(path, std::ios::binary) << text;
+        return path.string();
+    }
+
+    double distance(std::array<double, 3> const & a, std::array<double, 3> const & b) {
+        return std::hypot(a[0] - b[0], a[1] - b[1], a[2] - b[2]);
+    }
+
+}  // namespace
+
+TEST(Animation, frames_accumulate_overrides) {
+    Config base;
+    base.image_width = 320;
+    auto const frames = render::load_frames(
+        base, write_temp("utcommon_frames.txt", "samples_per_pixel: 2\n"
+                                                "frame:\n"
+                                                "  camera_position: 1 2 3\n"
+                                                "frame:\r\n"
+                                                "\n"
+                                                "frame:\n"
+                                                "  image_width: 64\n"));
+    ASSERT_EQ(frames.size(), 3U);
+    for (auto const & f : frames) {
+        EXPECT_EQ(f.samples_per_pixel, 2);
+    }
+    EXPECT_EQ(frames[0].camera_position, (std::array<double, 3>{1, 2, 3}));
+    EXPECT_EQ(frames[1].camera_position, frames[0].camera_position);
+    EXPECT_EQ(frames[1].image_width, 320);
+    EXPECT_EQ(frames[2].image_width, 64);
+}
+
+TEST(Animation, frames_file_errors) {
+    Config const base;
+    EXPECT_THROW(render::load_frames(base, write_temp("utcommon_frames.txt", "gamma: 2\n")),
+                 std::runtime_error);
+    try {
+        render::load_frames(base, write_temp("utcommon_frames.txt", "frame:\nzoom: 2\n"));
+        FAIL();
+    } catch (std::runtime_error const & e) {
+        EXPECT_STREQ(e.what(), "Error: Unknown configuration key: [zoom:]");
+    }
+}
+
+TEST(Animation, turntable_keeps_distance_and_height) {
+    Config base;
+    base.camera_position = {3, 2, -4};
+    base.camera_target   = {1, 0, 0};
+    auto const frames    = render::turntable_frames(base, 4);
+    ASSERT_EQ(frames.size(), 4U);
+    EXPECT_EQ(frames[0].camera_position, base.camera_position);
+    double const radius = distance(base.camera_position, base.camera_target);
+    for (auto const & f : frames) {
+        EXPECT_NEAR(distance(f.camera_position, f.camera_target), radius, 1e-12);
+        EXPECT_NEAR(f.camera_position[1], 2.0, 1e-12);
+    }
+    // Media vuelta: el punto opuesto respecto al eje vertical del objetivo
+    EXPECT_NEAR(frames[2].camera_position[0], -1.0, 1e-12);
+    EXPECT_NEAR(frames[2].camera_position[2], 4.0, 1e-12);
+}
+
+TEST(Animation, batch_options) {
+    Config const base;
+    render::options opts;
+    EXPECT_TRUE(render::batch_frames(opts, base).empty());
+    opts.turntable = 3;
+    EXPECT_EQ(render::batch_frames(opts, base).size(), 3U);
+    opts.checkpoint = "x.ckpt";
+    EXPECT_THROW(render::batch_frames(opts, base), std::runtime_error);
+    opts.checkpoint.clear();
+    opts.frames = "frames.txt";
+    EXPECT_THROW(render::batch_frames(opts, base), std::runtime_error);
+}
+
+TEST(Animation, frame_path_pads_number) {
+    EXPECT_EQ(render::frame_path("out/f####.ppm", 7), "out/f0007.ppm");
+    EXPECT_EQ(render::frame_path("f#.ppm", 12), "f12.ppm");
+    EXPECT_EQ(render::frame_path("a##b#.ppm", 3), "a03b#.ppm");
+    EXPECT_THROW(render::frame_path("out.ppm", 0), std::runtime_error);
+}
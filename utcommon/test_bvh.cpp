@@ -0,0 +1,121 @@
+#include <gtest/gtest.h>
+
+#include "bvh.hpp"
+
+#include <algorithm>
+#include <cstdint>
+#include <random>
+#include <vector>
+
+namespace {
+
+    std::vector<render::aabb> random_spheres(std::size_t n) {
+        std::mt19937_64 gen(7);
+        std::uniform_real_distribution<double> pos(-50.0, 50.0);
+        std::uniform_real_distribution<double> rad(0.1, 2.0);
+        std::vector<render::aabb> bounds;
+        for (std::size_t i = 0; i < n; ++i) {
+            double const x = pos(gen), y = pos(gen), z = pos(gen);
+            bounds.push_back(render::sphere_bounds({x, y, z}, rad(gen)));
+        }
+        return bounds;
+    }
+
+    bool contains(render::bvh_node const & outer, render::aabb const & inner) {
+        for (std::size_t k = 0; k < 3; ++k) {
+            if (inner.lo[k] < outer.lo[k] or inner.hi[k] > outer.hi[k]) {
+                return false;
+            }
+        }
+        return true;
+    }
+
+}  // namespace
+
+TEST(test_bvh, order_is_permutation) {
+    auto const bounds = random_spheres(1'000);
+    render::bvh const tree(bounds, 4);
+    auto order = tree.get_order();
+    std::ranges::sort(order);
+    for (std::size_t i = 0; i < order.size(); ++i) {
+        EXPECT_EQ(order[i], i);
+    }
+}
+
+TEST(test_bvh, leaves_cover_all_primitives_within_bounds) {
+    auto const bounds = random_spheres(1'000);
+    render::bvh const tree(bounds, 4);
+    std::size_t covered = 0;
+    for (auto const & node : tree.get_nodes()) {
+        for (std::size_t i = node.offset; node.count > 0 and i < node.offset + node.count; ++i) {
+            EXPECT_TRUE(contains(node, bounds[tree.get_order()[i]]));
+        }
+        covered += node.count;
+        EXPECT_LE(node.count, 4U);
+    }
+    EXPECT_EQ(covered, bounds.size());
+}
+
+TEST(test_bvh, deep_lopsided_build_keeps_every_primitive) {
+    // Cúmulo de más de 65535 primitivos y puntos cada vez más lejanos: el SAH separa un punto
+    // por nivel y llega a la profundidad máxima con el cúmulo entero sin partir
+    std::mt19937_64 gen(11);
+    std::uniform_real_distribution<double> pos(0.0, 1.0);
+    std::vector<render::aabb> bounds;
+    for (std::size_t i = 0; i < 70'000; ++i) {
+        bounds.push_back(render::sphere_bounds({pos(gen), pos(gen), pos(gen)}, 0.01));
+    }
+    double far = 1.0;
+    for (int i = 0; i < 60; ++i) {
+        far *= 32.0;
+        bounds.push_back(render::sphere_bounds({far, 0.5, 0.5}, 0.01));
+    }
+    render::bvh const tree(bounds, 4);
+    std::size_t covered = 0;
+    for (auto const & node : tree.get_nodes()) {
+        covered += node.count;
+    }
+    EXPECT_EQ(covered, bounds.size());
+    // La jerarquía respeta la profundidad que admite la pila del recorrido
+    EXPECT_NO_THROW(render::bvh(tree.get_nodes(), tree.get_order()));
+}
+
+TEST(test_bvh, cylinder_bounds_tilted) {
+    // Eje vertical: la caja es el radio en x/z y la semialtura en y
+    auto const box = render::cylinder_bounds({0.0, 0.0, 0.0}, 1.0, {0.0, 1.0, 0.0}, 2.0);
+    EXPECT_NEAR(box.lo[0], -1.0, 1e-6);
+    EXPECT_NEAR(box.hi[1], 2.0, 1e-6);
+    EXPECT_NEAR(box.hi[2], 1.0, 1e-6);
+}
+
+TEST(test_bvh, parse_accel) {
+    EXPECT_EQ(render::parse_accel("bvh"), render::accel_kind::bvh);
+    EXPECT_EQ(render::parse_accel("none"), render::accel_kind::none);
+    EXPECT_THROW(render::parse_accel("kdtree"), std::runtime_error);
+}
+
+TEST(test_bvh, refit_covers_moved_primitives) {
+    auto bounds = random_spheres(1'000);
+    render::bvh tree(bounds, 4);
+    // Cajas en el orden de las hojas, con algunos primitivos desplazados
+    std::vector<render::aabb> moved;
+    for (std::uint32_t const idx : tree.get_order()) {
+        moved.push_back(bounds[idx]);
+    }
+    for (std::size_t i = 0; i < moved.size(); i += 37) {
+        moved[i] = render::sphere_bounds({60.0, -60.0, static_cast<double>(i)}, 3.0);
+    }
+    tree.refit(moved);
+    auto const & nodes = tree.get_nodes();
+    for (std::size_t n = 0; n < nodes.size(); ++n) {
+        auto const & node = nodes[n];
+        if (node.count > 0) {
+            for (std::size_t i = node.offset; i < node.offset + node.count; ++i) {
+                EXPECT_TRUE(contains(node, moved[i]));
+            }
+        } else {
+            EXPECT_TRUE(contains(node, {nodes[n + 1].lo, nodes[n + 1].hi}));
+            EXPECT_TRUE(contains(node, {nodes[node.offset].lo, nodes[node.offset].hi}));
+        }
+    }
+}
@@ -0,0 +1,73 @@
+#include <gtest/gtest.h>
+
+#include "color.hpp"
+
+#include <array>
+#include <cmath>
+#include <limits>
+#include <random>
+#include <vector>
+
+TEST(Color, table_matches_pow) {
+    std::mt19937_64 gen(11);
+    std::uniform_real_distribution<double> unit(0.0, 1.0);
+    for (double const gamma : {1.0, 1.8, 2.2, 2.4, 0.5}) {
+        render::tone_mapper const mapper(gamma);
+        for (int i = 0; i < 100'000; ++i) {
+            double const v = unit(gen);
+            ASSERT_EQ(mapper.to_u8(v), render::to_u8(v, gamma))
+                << "gamma " << gamma << " v " << v;
+        }
+    }
+}
+
+TEST(Color, table_matches_pow_at_level_edges) {
+    for (double const gamma : {1.0, 2.2}) {
+        render::tone_mapper const mapper(gamma);
+        // Alrededor de cada cambio de nivel, a un ulp de distancia
+        for (int k = 0; k < 255; ++k) {
+            double const edge = std::pow((static_cast<double>(k) + 0.5) / 255.0, gamma);
+            double v          = std::nextafter(edge, 0.0);
+            for (int step = 0; step < 5; ++step) {
+                ASSERT_EQ(mapper.to_u8(v), render::to_u8(v, gamma))
+                << "gamma " << gamma << " v " << v;
+                v = std::nextafter(v, 1.0);
+            }
+        }
+    }
+}
+
+TEST(Color, table_clamps_out_of_range) {
+    render::tone_mapper const mapper(2.2);
+    EXPECT_EQ(mapper.to_u8(0.0), 0);
+    EXPECT_EQ(mapper.to_u8(-3.0), 0);
+    EXPECT_EQ(mapper.to_u8(std::numeric_limits<double>::denorm_min()), 0);
+    EXPECT_EQ(mapper.to_u8(1.0), 255);
+    EXPECT_EQ(mapper.to_u8(std::nextafter(1.0, 0.0)), 255);
+    EXPECT_EQ(mapper.to_u8(7.5), 255);
+    EXPECT_EQ(mapper.to_u8(std::numeric_limits<double>::infinity()), 255);
+}
+
+TEST(Color, non_positive_gamma_uses_pow) {
+    for (double const gamma : {0.0, -1.5, std::numeric_limits<double>::infinity()}) {
+        render::tone_mapper const mapper(gamma);
+        for (double const v : {0.0, 0.1, 0.5, 0.9, 1.0}) {
+            EXPECT_EQ(mapper.to_u8(v), render::to_u8(v, gamma))
+                << "gamma " << gamma << " v " << v;
+        }
+    }
+}
+
+TEST(Color, convert_matches_to_rgb8) {
+    std::vector<float> const linear = {0.0F, 0.5F, 1.0F, 0.25F, 0.75F, 2.0F, -1.0F, 0.01F, 0.99F};
+    std::vector<render::rgb8> out(linear.size() / 3);
+    render::tone_mapper const mapper(2.2);
+    mapper.convert(linear, out);
+    for (std::size_t i = 0; i < out.size(); ++i) {
+        auto const expected =
+            render::to_rgb8({linear[3 * i], linear[3 * i + 1], linear[3 * i + 2]}, 2.2);
+        EXPECT_EQ(out[i][0], expected[0]);
+        EXPECT_EQ(out[i][1], expected[1]);
+        EXPECT_EQ(out[i][2], expected[2]);
+    }
+}
@@ -0,0 +1,41 @@
+#include <gtest/gtest.h>
+
+#include "framebuffer.hpp"
+
+#include <vector>
+
+TEST(Framebuffer, stores_linear_color) {
+    render::framebuffer image(4, 3);
+    EXPECT_EQ(image.get_width(), 4);
+    EXPECT_EQ(image.get_height(), 3);
+    EXPECT_EQ(image.index(2, 1), 9U);
+    image.set(image.index(2, 1), {0.25, 0.5, 2.0});
+    render::vector const c = image.get(9);
+    EXPECT_EQ(c.get_x(), 0.25);
+    EXPECT_EQ(c.get_y(), 0.5);
+    EXPECT_EQ(c.get_z(), 2.0);
+    EXPECT_EQ(image.get(0).get_x(), 0.0);
+
+    // Las filas son canales intercalados: tres float por píxel
+    auto const row = image.rows(2, 1);
+    ASSERT_EQ(row.size(), 12U);
+    EXPECT_EQ(row[3], 0.25F);
+    EXPECT_EQ(row[5], 2.0F);
+}
+
+TEST(Framebuffer, packs_rows) {
+    render::framebuffer image(2, 2);
+    image.set(0, {1.0, 0.0, 0.5});
+    image.set(3, {0.2, 0.4, 0.6});
+    render::tone_mapper const mapper(1.0);
+
+    std::vector<render::rgb8> const all = image.pack(mapper);
+    ASSERT_EQ(all.size(), 4U);
+    EXPECT_EQ(all[0], (render::rgb8{255, 0, 128}));
+    EXPECT_EQ(all[1], (render::rgb8{0, 0, 0}));
+    EXPECT_EQ(all[3], (render::rgb8{51, 102, 153}));
+
+    std::vector<render::rgb8> second(2);
+    image.pack_rows(1, 1, mapper, second);
+    EXPECT_EQ(second[1], all[3]);
+}
@@ -0,0 +1,53 @@
+#include <gtest/gtest.h>
+
+#include "geometry.hpp"
+
+#include <limits>
+
+namespace {
+    constexpr double inf = std::numeric_limits<double>::infinity();
+}
+
+TEST(test_geometry, sphere_hit_front) {
+    render::ray r{{0.0, 0.0, -5.0}, {0.0, 0.0, 1.0}};
+    double t = 0.0;
+    ASSERT_TRUE(render::hit_sphere(r, {0.0, 0.0, 0.0}, 1.0, 1e-3, inf, t));
+    EXPECT_DOUBLE_EQ(t, 4.0);
+}
+
+TEST(test_geometry, sphere_miss) {
+    render::ray r{{0.0, 2.0, -5.0}, {0.0, 0.0, 1.0}};
+    double t = 0.0;
+    EXPECT_FALSE(render::hit_sphere(r, {0.0, 0.0, 0.0}, 1.0, 1e-3, inf, t));
+}
+
+TEST(test_geometry, sphere_hit_from_inside) {
+    render::ray r{{0.0, 0.0, 0.0}, {1.0, 0.0, 0.0}};
+    double t = 0.0;
+    ASSERT_TRUE(render::hit_sphere(r, {0.0, 0.0, 0.0}, 2.0, 1e-3, inf, t));
+    EXPECT_DOUBLE_EQ(t, 2.0);
+}
+
+TEST(test_geometry, cylinder_hit_side) {
+    render::ray r{{-5.0, 0.0, 0.0}, {1.0, 0.0, 0.0}};
+    double t = 0.0;
+    ASSERT_TRUE(render::hit_cylinder(r, {0.0, 0.0, 0.0}, 1.0, {0.0, 1.0, 0.0}, 2.0, 1e-3, inf, t));
+    EXPECT_DOUBLE_EQ(t, 4.0);
+    auto n = render::cylinder_normal(r.at(t), {0.0, 0.0, 0.0}, 1.0, {0.0, 1.0, 0.0}, 2.0);
+    EXPECT_DOUBLE_EQ(n.get_x(), -1.0);
+}
+
+TEST(test_geometry, cylinder_hit_cap) {
+    render::ray r{{0.0, 5.0, 0.0}, {0.0, -1.0, 0.0}};
+    double t = 0.0;
+    ASSERT_TRUE(render::hit_cylinder(r, {0.0, 0.0, 0.0}, 1.0, {0.0, 1.0, 0.0}, 2.0, 1e-3, inf, t));
+    EXPECT_DOUBLE_EQ(t, 3.0);
+    auto n = render::cylinder_normal(r.at(t), {0.0, 0.0, 0.0}, 1.0, {0.0, 1.0, 0.0}, 2.0);
+    EXPECT_DOUBLE_EQ(n.get_y(), 1.0);
+}
+
+TEST(test_geometry, cylinder_miss_beyond_height) {
+    render::ray r{{-5.0, 3.0, 0.0}, {1.0, 0.0, 0.0}};
+    double t = 0.0;
+    EXPECT_FALSE(render::hit_cylinder(r, {0.0, 0.0, 0.0}, 1.0, {0.0, 1.0, 0.0}, 2.0, 1e-3, inf, t));
+}
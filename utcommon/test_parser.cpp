@@ -0,0 +1,165 @@
+#include <gtest/gtest.h>
+
+#include "parser.hpp"
+
+#include <filesystem>
+#include <fstream>
+#include <stdexcept>
+#include <string>
+
+namespace {
+
+    std::string write_temp(std::string const & name, std::string const & text) {
+        auto const path = std::filesystem::temp_directory_path() / name;
+        std::ofstream(path, std::ios::binary) << text;
+        return path.string();
+    }
+
+    std::string scene_error(std::string const & text) {
+        try {
+            parseScene(write_temp("utcommon_scene.txt", text));
+        } catch (std::runtime_error const & e) {
+            return e.what();
+        }
+        return {};
+    }
+
+    std::string config_error(std::string const & text) {
+        try {
+            parseConfig(write_temp("utcommon_config.txt", text));
+        } catch (std::exception const & e) {
+            return e.what();
+        }
+        return {};
+    }
+
+}  // namespace
+
+TEST(Parser, reads_config_values) {
+    Config const cfg = parseConfig(write_temp("utcommon_config.txt",
+                                              "\n  image_width: 640\r\n"
+                                              "aspect_ratio: 4 3\n"
+                                              "gamma: +1.8\n"
+                                              "camera_position: -1 2.5 1e1\n"
+                                              "threads: 3\n"
+                                              "adaptive_threshold: 0.01\n"
+                                              "adaptive_round: 8"));
+    EXPECT_EQ(cfg.image_width, 640);
+    EXPECT_EQ(cfg.aspect_ratio, std::make_pair(4, 3));
+    EXPECT_DOUBLE_EQ(cfg.gamma, 1.8);
+    EXPECT_DOUBLE_EQ(cfg.camera_position[2], 10.0);
+    EXPECT_EQ(cfg.threads, 3);
+    EXPECT_DOUBLE_EQ(cfg.adaptive_threshold, 0.01);
+    EXPECT_EQ(cfg.adaptive_round, 8);
+}
+
+TEST(Parser, reads_scene) {
+    std::string const path  = write_temp("utcommon_scene.txt",
+                                         "matte: m 0.5 0.5 0.5\n"
+                                         "refractive: g 1.5\n"
+                                         "sphere: 0 1 2 0.5 m\n"
+                                         "cylinder: 1 2 3 0.5 0 2 0 g");
+    auto const [mats, objs] = parseScene(path);
+    ASSERT_EQ(mats.size(), 2U);
+    ASSERT_EQ(objs.size(), 2U);
+    EXPECT_EQ(objs[1].type, ObjectType::Cylinder);
+    EXPECT_EQ(objs[0].material_index, 0U);
+    EXPECT_EQ(objs[1].material_index, 1U);
+    EXPECT_EQ(readObjectLine(path, objs[1]), "cylinder: 1 2 3 0.5 0 2 0 g");
+    EXPECT_DOUBLE_EQ(objs[1].params[5], 2.0);
+}
+
+TEST(Parser, keeps_error_messages) {
+    EXPECT_EQ(config_error("image_width: 0\n"),
+              "Error: Invalid value for key: [image_width:]\nLine: \"image_width: 0\"");
+    EXPECT_EQ(config_error("gamma: 1 2\n"),
+              "Error: Extra data after configuration value for key: [gamma:]\nExtra: \"2\"\n"
+              "Line: \"gamma: 1 2\"");
+    EXPECT_EQ(config_error("gamma: 1.5x\n"), "trailing");
+    EXPECT_EQ(config_error("max_depth: abc\n"), "stoi");
+    // Los subnormales desbordan por abajo en std::stod
+    EXPECT_EQ(config_error("gamma: 1e-310\n"), "stod");
+    EXPECT_EQ(config_error("gamma: -0x1p-1070\n"), "stod");
+    EXPECT_EQ(config_error("gamma: 0.0e-400\n"), "");
+    EXPECT_EQ(config_error("zoom: 2\n"), "Error: Unknown configuration key: [zoom:]");
+    EXPECT_EQ(config_error("adaptive_threshold: -0.1\n"),
+              "Error: Invalid value for key: [adaptive_threshold:]\n"
+              "Line: \"adaptive_threshold: -0.1\"");
+    EXPECT_EQ(config_error("adaptive_round: 0\n"),
+              "Error: Invalid value for key: [adaptive_round:]\nLine: \"adaptive_round: 0\"");
+    EXPECT_EQ(scene_error("matte: m 0.5 0.5 2\n"),
+              "Error: Invalid matte material parameters\nLine: \"matte: m 0.5 0.5 2\"");
+    EXPECT_EQ(scene_error("matte: m 1 1 1\nmetal: m 1 1 1 0\n"),
+              "Error: Material with name [m] already exists\nLine: \"metal: m 1 1 1 0\"");
+    EXPECT_EQ(scene_error("sphere: 0 0 0 1 nope\n"),
+              "Error: Material not found: [nope]\nLine: \"sphere: 0 0 0 1 nope\"");
+    EXPECT_EQ(scene_error("box: 1\n"), "Error: Unknown scene entity: box");
+    EXPECT_EQ(scene_error("matte: m 1e-320 0.5 0.5\n"),
+              "Error: Invalid matte material parameters\nLine: \"matte: m 1e-320 0.5 0.5\"");
+    EXPECT_EQ(scene_error("matte: m 1 1 1\nsphere: 0 0 0 4.9e-324 m\n"),
+              "Error: Invalid sphere parameters\nLine: \"sphere: 0 0 0 4.9e-324 m\"");
+}
+
+namespace {
+
+    // Escena de unos 2 MB: bastante para que se reparta en varios trozos
+    std::string large_scene(std::size_t objects) {
+        std::string text = "matte: m 0.5 0.5 0.5\nmetal: s 0.7 0.7 0.7 0.1\n";
+        for (std::size_t i = 0; i < objects; ++i) {
+            auto const v = std::to_string(static_cast<double>(i) * 0.25);
+            if (i % 3 == 0) {
+                text += "cylinder: " + v + " 1 2 0.5 0 1 0 s\n";
+            } else {
+                text += "sphere: " + v + " -1.5 3 0.25 m\n";
+            }
+        }
+        return text;
+    }
+
+    std::string parallel_error(std::string const & text, render::work_stealing_pool & pool) {
+        try {
+            parseScene(write_temp("utcommon_large.txt", text), pool);
+        } catch (std::runtime_error const & e) {
+            return e.what();
+        }
+        return {};
+    }
+
+}  // namespace
+
+TEST(Parser, parallel_matches_sequential) {
+    render::work_stealing_pool pool(4);
+    std::string const path = write_temp("utcommon_large.txt", large_scene(60'000));
+    auto const [mats_a, objs_a] = parseScene(path);
+    auto const [mats_b, objs_b] = parseScene(path, pool);
+    ASSERT_EQ(mats_b.size(), mats_a.size());
+    ASSERT_EQ(objs_b.size(), objs_a.size());
+    for (std::size_t i = 0; i < objs_a.size(); ++i) {
+        ASSERT_EQ(objs_b[i].params, objs_a[i].params);
+        ASSERT_EQ(objs_b[i].material_index, objs_a[i].material_index);
+        ASSERT_EQ(objs_b[i].line_offset, objs_a[i].line_offset);
+    }
+}
+
+TEST(Parser, parallel_reports_first_error) {
+    render::work_stealing_pool pool(4);
+    std::string const text = large_scene(60'000);
+    std::string const late_material = "sphere: 0 0 0 1 late\n";
+    std::string const late_def      = "matte: late 0.1 0.2 0.3\n";
+    std::string const bad_sphere    = "sphere: 0 0 0 -1 m\n";
+
+    // Material usado en el primer trozo y definido en el último
+    std::string scene = text;
+    scene.insert(scene.size() - 1'000'000, late_def);
+    scene.insert(scene.find('\n', 1'000) + 1, late_material);
+    scene.insert(scene.find('\n', scene.size() - 500'000) + 1, bad_sphere);
+    EXPECT_EQ(parallel_error(scene, pool),
+              "Error: Material not found: [late]\nLine: \"sphere: 0 0 0 1 late\"");
+
+    // Error de valores en un trozo posterior a un duplicado
+    scene = text;
+    scene.insert(scene.find('\n', scene.size() - 500'000) + 1, bad_sphere);
+    scene.insert(scene.find('\n', 1'500'000) + 1, "matte: m 0.1 0.1 0.1\n");
+    EXPECT_EQ(parallel_error(scene, pool),
+              "Error: Material with name [m] already exists\nLine: \"matte: m 0.1 0.1 0.1\"");
+}
@@ -0,0 +1,83 @@
+#include <gtest/gtest.h>
+
+#include "ppm.hpp"
+#include "tiles.hpp"
+
+#include <array>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+namespace {
+
+    std::vector<render::rgb8> const pixels = {
+        {0,   7,   255},
+        {12,  128, 99 },
+        {255, 255, 255},
+        {1,   0,   10 },
+        {200, 34,  5  },
+        {9,   99,  199},
+    };
+
+}  // namespace
+
+TEST(Ppm, p3_matches_stream_output) {
+    std::ostringstream expected;
+    expected << "P3\n" << 2 << " " << 3 << "\n255\n";
+    for (auto const & p : pixels) {
+        expected << int{p[0]} << " " << int{p[1]} << " " << int{p[2]} << "\n";
+    }
+
+    std::ostringstream out;
+    render::ppm_writer writer(out, 3, 2, render::ppm_format::p3);
+    writer.write(std::span(pixels).first(3));
+    writer.write(std::span(pixels).last(3));
+    writer.finish();
+    EXPECT_EQ(out.str(), expected.str());
+}
+
+TEST(Ppm, p6_is_binary) {
+    std::ostringstream out;
+    render::ppm_writer writer(out, 3, 2, render::ppm_format::p6);
+    writer.write(pixels);
+    writer.finish();
+    std::string const data = out.str();
+    std::string const header = "P6\n2 3\n255\n";
+    ASSERT_EQ(data.size(), header.size() + 3 * pixels.size());
+    EXPECT_EQ(data.substr(0, header.size()), header);
+    EXPECT_EQ(static_cast<unsigned char>(data[header.size() + 2]), 255);
+    EXPECT_EQ(static_cast<unsigned char>(data[header.size() + 4]), 128);
+}
+
+TEST(Ppm, parse_format) {
+    EXPECT_EQ(render::parse_ppm_format("p3"), render::ppm_format::p3);
+    EXPECT_EQ(render::parse_ppm_format("p6"), render::ppm_format::p6);
+    EXPECT_THROW(render::parse_ppm_format("png"), std::runtime_error);
+}
+
+TEST(BandTracker, emits_rows_in_order) {
+    int const width  = 40;
+    int const height = 35;
+    auto const tiles = render::make_tiles(width, height);
+    // Con gamma 1 cada píxel se cuantiza al número de su fila
+    render::framebuffer image(width, height);
+    for (int row = 0; row < height; ++row) {
+        for (int col = 0; col < width; ++col) {
+            double const v = static_cast<double>(row) / 255.0;
+            image.set(image.index(row, col), {v, v, v});
+        }
+    }
+    render::tone_mapper const mapper(1.0);
+    std::vector<std::size_t> emitted;
+    render::band_tracker progress(tiles, image, mapper, [&](auto rows) {
+        emitted.push_back(rows.front()[0]);
+        emitted.push_back(rows.size());
+    });
+    // Se completan las teselas en orden inverso: nada sale hasta terminar la primera franja
+    for (std::size_t t = tiles.size(); t-- > 0;) {
+        progress.tile_done(t);
+    }
+    std::vector<std::size_t> const expected = {0, 16 * 40, 16, 16 * 40, 32, 3 * 40};
+    EXPECT_EQ(emitted, expected);
+}
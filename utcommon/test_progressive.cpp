@@ -0,0 +1,112 @@
+#include <gtest/gtest.h>
+
+#include "progressive.hpp"
+
+#include <filesystem>
+#include <fstream>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+
+namespace {
+
+    std::string temp_path(std::string const & name) {
+        return (std::filesystem::temp_directory_path() / name).string();
+    }
+
+    // Pasada de prueba: una muestra de valor fijo por píxel
+    void fake_pass(render::progress_state & state) {
+        for (auto & px : state.pixels) {
+            render::pixel_estimate est;
+            for (int s = 0; s < state.pass_samples; ++s) {
+                est.add({0.5, 0.25, 1.0});
+            }
+            px.merge(est);
+        }
+        ++state.passes_done;
+    }
+
+    std::string read_error(std::string const & path, render::progress_state const & expected) {
+        try {
+            [[maybe_unused]] auto const state = render::read_checkpoint(path, expected);
+        } catch (std::runtime_error const & e) {
+            return e.what();
+        }
+        return {};
+    }
+
+}  // namespace
+
+TEST(Progressive, checkpoint_round_trip) {
+    std::string const path = temp_path("utcommon_checkpoint.rck");
+    std::filesystem::remove(path);
+    render::progress_state state(4, 3, 2, 77);
+    EXPECT_FALSE(render::read_checkpoint(path, state).has_value());
+
+    fake_pass(state);
+    render::write_checkpoint(path, state);
+    auto const loaded = render::read_checkpoint(path, render::progress_state(4, 3, 2, 77));
+    ASSERT_TRUE(loaded.has_value());
+    EXPECT_EQ(loaded->passes_done, 1);
+    EXPECT_EQ(loaded->pixels[5].get_count(), 2);
+    EXPECT_EQ(loaded->pixels[5].mean().get_y(), 0.25);
+    EXPECT_FALSE(std::filesystem::exists(path + ".tmp"));
+}
+
+TEST(Progressive, rejects_other_renders) {
+    std::string const path = temp_path("utcommon_checkpoint.rck");
+    render::progress_state state(4, 3, 2, 77);
+    render::write_checkpoint(path, state);
+
+    std::string const mismatch = "Error: Checkpoint does not match this render: [" + path + "]";
+    EXPECT_EQ(read_error(path, render::progress_state(4, 3, 2, 78)), mismatch);
+    EXPECT_EQ(read_error(path, render::progress_state(4, 3, 1, 77)), mismatch);
+    EXPECT_EQ(read_error(path, render::progress_state(3, 4, 2, 77)), mismatch);
+
+    // Un byte cambiado en los píxeles no pasa la suma de comprobación
+    {
+        std::fstream file(path, std::ios::binary | std::ios::in | std::ios::out);
+        file.seekp(70);
+        file.put('\x7f');
+    }
+    EXPECT_EQ(read_error(path, state), "Error: Corrupt checkpoint: [" + path + "]");
+}
+
+TEST(Progressive, resumes_after_interruption) {
+    std::string const checkpoint = temp_path("utcommon_resume.rck");
+    std::string const output     = temp_path("utcommon_resume.ppm");
+    std::filesystem::remove(checkpoint);
+    Config cfg;
+    cfg.samples_per_pixel = 10;  // tres pasadas de 4 muestras, la última de 2
+    render::progressive_job const job{checkpoint, output, render::ppm_format::p3, 0};
+    std::ostringstream log;
+
+    // El trabajo se interrumpe durante la segunda pasada
+    render::progress_state first(2, 2, 4, 5);
+    int calls = 0;
+    EXPECT_THROW(render::run_progressive(cfg, job, first,
+                                         [&](render::progress_state & st) {
+                                             if (++calls == 2) {
+                                                 throw std::runtime_error("killed");
+                                             }
+                                             fake_pass(st);
+                                         },
+                                         log),
+                 std::runtime_error);
+    EXPECT_TRUE(std::filesystem::exists(output));
+
+    render::progress_state second(2, 2, 4, 5);
+    calls = 0;
+    render::run_progressive(cfg, job, second,
+                            [&](render::progress_state & st) {
+                                ++calls;
+                                fake_pass(st);
+                            },
+                            log);
+    EXPECT_EQ(calls, 2);
+    EXPECT_EQ(second.passes_done, 3);
+    EXPECT_NE(log.str().find("(1/3 passes)"), std::string::npos);
+    auto const done = render::read_checkpoint(checkpoint, render::progress_state(2, 2, 4, 5));
+    ASSERT_TRUE(done.has_value());
+    EXPECT_EQ(done->passes_done, 3);
+}
@@ -0,0 +1,139 @@
+#include <gtest/gtest.h>
+
+#include "render_server.hpp"
+
+#include <chrono>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <thread>
+#include <unistd.h>
+
+namespace {
+
+    std::string write_temp(std::string const & name, std::string const & text) {
+        auto const path = std::filesystem::temp_directory_path() / name;
+        std::ofstream(path, std::ios::binary) << text;
+        return path.string();
+    }
+
+    // Envía una petición y devuelve la respuesta completa; reintenta hasta que el servidor
+    // escucha
+    std::string submit(std::string const & socket_path, std::string const & request) {
+        sockaddr_un addr{};
+        addr.sun_family = AF_UNIX;
+        std::memcpy(addr.sun_path, socket_path.c_str(), socket_path.size() + 1);
+        for (int attempt = 0; attempt < 500; ++attempt) {
+            int const fd = ::socket(AF_UNIX, SOCK_STREAM, 0);
+            if (::connect(fd, reinterpret_cast<sockaddr const *>(&addr), sizeof(addr)) != 0) {
+                ::close(fd);
+                std::this_thread::sleep_for(std::chrono::milliseconds(10));
+                continue;
+            }
+            std::string const line = request + "\n";
+            EXPECT_EQ(::send(fd, line.data(), line.size(), 0), static_cast<ssize_t>(line.size()));
+            std::string reply;
+            char chunk[256];
+            ssize_t n = 0;
+            while ((n = ::recv(fd, chunk, sizeof(chunk), 0)) > 0) {
+                reply.append(chunk, static_cast<std::size_t>(n));
+            }
+            ::close(fd);
+            return reply;
+        }
+        ADD_FAILURE() << "server not listening";
+        return {};
+    }
+
+    struct counted_scene {
+        int id;
+    };
+
+}  // namespace
+
+TEST(RenderServer, parses_requests) {
+    auto const req = render::parse_request("  cfg.txt\tscene.txt \r");
+    EXPECT_EQ(req.config_path, "cfg.txt");
+    EXPECT_EQ(req.scene_path, "scene.txt");
+    EXPECT_THROW((void)render::parse_request("cfg.txt"), std::runtime_error);
+    EXPECT_THROW((void)render::parse_request("a b c"), std::runtime_error);
+}
+
+TEST(RenderServer, cache_is_keyed_by_content) {
+    auto const a    = write_temp("utcommon_lru_a.txt", "sphere: 0 0 0 1 m\n");
+    auto const same = write_temp("utcommon_lru_b.txt", "sphere: 0 0 0 1 m\n");
+    auto const b    = write_temp("utcommon_lru_c.txt", "sphere: 0 0 0 2 m\n");
+    auto const c    = write_temp("utcommon_lru_d.txt", "sphere: 0 0 0 3 m\n");
+    int built       = 0;
+    int reloaded    = 0;
+    auto const make = [&](counted_scene const * previous) {
+        reloaded = (previous != nullptr) ? previous->id : 0;
+        return counted_scene{++built};
+    };
+
+    render::scene_lru<counted_scene> lru(2);
+    EXPECT_EQ(lru.get(a, make)->id, 1);
+    EXPECT_EQ(lru.get(same, make)->id, 1);  // mismo contenido, otra ruta
+    EXPECT_EQ(lru.get(b, make)->id, 2);
+    EXPECT_EQ(lru.get(a, make)->id, 1);     // a pasa a ser la más reciente
+    EXPECT_EQ(lru.get(c, make)->id, 3);     // expulsa b
+    EXPECT_EQ(lru.size(), 2U);
+    EXPECT_EQ(lru.get(a, make)->id, 1);
+    EXPECT_EQ(lru.get(b, make)->id, 4);
+    EXPECT_EQ(lru.hits(), 3U);
+    EXPECT_EQ(lru.misses(), 4U);
+
+    EXPECT_EQ(reloaded, 0);
+
+    // Un fichero modificado no reutiliza la escena anterior, pero la recibe para recargarla
+    write_temp("utcommon_lru_a.txt", "sphere: 0 0 0 5 m\n");
+    EXPECT_EQ(lru.get(a, make)->id, 5);
+    EXPECT_EQ(reloaded, 1);
+    EXPECT_EQ(lru.size(), 2U);
+    EXPECT_EQ(lru.get(same, make)->id, 6);  // la versión anterior ya no está en la caché
+}
+
+TEST(RenderServer, serves_jobs_until_quit) {
+    auto const socket_path =
+        (std::filesystem::temp_directory_path() / "utcommon_server.sock").string();
+    std::ostringstream log;
+    std::thread server([&] {
+        render::serve(
+            socket_path,
+            [](render::render_request const & req, std::ostream & out) {
+                if (req.config_path == "bad") {
+                    throw std::runtime_error("Error: bad config");
+                }
+                out << "P3 " << req.config_path << " " << req.scene_path << "\n";
+            },
+            log);
+    });
+    EXPECT_EQ(submit(socket_path, "cfg.txt scene.txt"), "P3 cfg.txt scene.txt\n");
+    EXPECT_EQ(submit(socket_path, "bad scene.txt"), "Error: bad config\n");
+    EXPECT_EQ(submit(socket_path, "only-one"), "Error: Invalid request: [only-one]\n");
+    EXPECT_EQ(submit(socket_path, "quit"), "");
+    server.join();
+    EXPECT_FALSE(std::filesystem::exists(socket_path));
+    EXPECT_NE(log.str().find("Served cfg.txt scene.txt"), std::string::npos);
+}
+
+TEST(RenderServer, keeps_existing_files) {
+    auto const path = write_temp("utcommon_not_a_socket.txt", "precious\n");
+    std::ostringstream log;
+    try {
+        render::serve(path, [](render::render_request const &, std::ostream &) {}, log);
+        FAIL();
+    } catch (std::runtime_error const & e) {
+        EXPECT_EQ(std::string(e.what()),
+                  "Error: Could not listen on socket: [" + path + "]: Not a socket");
+    }
+    std::ifstream in(path);
+    std::string line;
+    ASSERT_TRUE(std::getline(in, line));
+    EXPECT_EQ(line, "precious");
+}
@@ -0,0 +1,44 @@
+#include <gtest/gtest.h>
+
+#include "rng.hpp"
+
+#include <array>
+#include <cstdint>
+#include <set>
+
+TEST(Rng, philox_known_answers) {
+    // Vectores de referencia de Random123 para Philox4x32-10
+    using block = std::array<std::uint32_t, 4>;
+    EXPECT_EQ(render::philox4x32({0, 0, 0, 0}, {0, 0}),
+              (block{0x6627'e8d5, 0xe169'c58d, 0xbc57'ac4c, 0x9b00'dbd8}));
+    EXPECT_EQ(render::philox4x32({0xffff'ffff, 0xffff'ffff, 0xffff'ffff, 0xffff'ffff},
+                                 {0xffff'ffff, 0xffff'ffff}),
+              (block{0x408f'276d, 0x41c8'3b0e, 0xa20b'c7c6, 0x6d54'51fd}));
+    EXPECT_EQ(render::philox4x32({0x243f'6a88, 0x85a3'08d3, 0x1319'8a2e, 0x0370'7344},
+                                 {0xa409'3822, 0x299f'31d0}),
+              (block{0xd16c'fe09, 0x94fd'cceb, 0x5001'e420, 0x2412'6ea1}));
+}
+
+TEST(Rng, streams_are_reproducible) {
+    std::uint64_t const key = render::rng_key(7);
+    render::rng_engine a(key, {12, 3}, 1);
+    render::rng_engine b(key, {12, 3}, 1);
+    for (int i = 0; i < 9; ++i) {
+        EXPECT_EQ(a(), b());
+    }
+}
+
+TEST(Rng, streams_are_independent) {
+    // El primer número de flujos vecinos (otra clave, píxel, muestra o rebote) no se repite
+    std::uint64_t const key = render::rng_key(7);
+    std::set<std::uint64_t> first;
+    for (std::uint32_t s = 0; s < 4; ++s) {
+        for (std::uint32_t bounce = 0; bounce < 4; ++bounce) {
+            first.insert(render::rng_engine(key, {1, s}, bounce)());
+            first.insert(render::rng_engine(key, {1ULL << 32U, s}, bounce)());
+            first.insert(render::rng_engine(render::rng_key(8), {1, s}, bounce)());
+        }
+    }
+    EXPECT_EQ(first.size(), 48U);
+    EXPECT_NE(render::rng_key(0), render::rng_key(1));
+}
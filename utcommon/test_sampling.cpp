@@ -0,0 +1,64 @@
+#include <gtest/gtest.h>
+
+#include "sampling.hpp"
+
+#include <cmath>
+
+TEST(Sampling, estimate_mean_and_error) {
+    render::pixel_estimate est;
+    EXPECT_TRUE(std::isinf(est.display_error(1.0)));
+    est.add({1.0, 0.5, 0.0});
+    EXPECT_TRUE(std::isinf(est.display_error(1.0)));
+    est.add({3.0, 0.5, 0.0});
+    EXPECT_EQ(est.get_count(), 2);
+    EXPECT_DOUBLE_EQ(est.mean().get_x(), 2.0);
+    EXPECT_DOUBLE_EQ(est.mean().get_y(), 0.5);
+    // Canal x: s² = 2, error típico sqrt(2 / 2); con gamma 2 se multiplica por la pendiente
+    // de sqrt(v) en la media
+    EXPECT_DOUBLE_EQ(est.display_error(1.0), 1.0);
+    EXPECT_DOUBLE_EQ(est.display_error(2.0), 0.5 / std::sqrt(2.0));
+}
+
+TEST(Sampling, policy_stops_at_rounds) {
+    Config cfg;
+    cfg.samples_per_pixel  = 10;
+    cfg.adaptive_round     = 4;
+    cfg.adaptive_threshold = 0.1;
+    cfg.gamma              = 1.0;
+    render::sample_policy const policy(cfg);
+    render::pixel_estimate flat;
+    for (int s = 0; s < 3; ++s) {
+        flat.add({0.5, 0.5, 0.5});
+        EXPECT_FALSE(policy.done(flat));
+    }
+    flat.add({0.5, 0.5, 0.5});
+    EXPECT_TRUE(policy.done(flat));
+
+    // Con mucha varianza sigue hasta el máximo
+    render::pixel_estimate noisy;
+    for (int s = 0; s < 10; ++s) {
+        EXPECT_FALSE(policy.done(noisy));
+        noisy.add({(s % 2 == 0) ? 0.0 : 1.0, 0.0, 0.0});
+    }
+    EXPECT_TRUE(policy.done(noisy));
+
+    // Sin umbral se toman siempre todas las muestras
+    cfg.adaptive_threshold = 0.0;
+    render::sample_policy const fixed(cfg);
+    EXPECT_FALSE(fixed.done(flat));
+}
+
+TEST(Sampling, batch_reaches_next_check) {
+    Config cfg;
+    cfg.samples_per_pixel  = 10;
+    cfg.adaptive_round     = 4;
+    cfg.adaptive_threshold = 0.1;
+    render::sample_policy const policy(cfg);
+    EXPECT_EQ(policy.batch_size(0), 4);
+    EXPECT_EQ(policy.batch_size(5), 3);
+    EXPECT_EQ(policy.batch_size(8), 2);
+
+    cfg.adaptive_threshold = 0.0;
+    EXPECT_EQ(render::sample_policy(cfg).batch_size(3), 7);
+    EXPECT_EQ(render::sample_policy(4).batch_size(0), 4);
+}
@@ -0,0 +1,149 @@
+#include <gtest/gtest.h>
+
+#include "scene_cache.hpp"
+
+#include <array>
+#include <filesystem>
+#include <fstream>
+#include <iterator>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+namespace {
+
+    std::string temp_path(std::string const & name) {
+        return (std::filesystem::temp_directory_path() / name).string();
+    }
+
+    std::vector<Material> sample_materials() {
+        return {
+            {"mate",   MaterialType::Matte,      {0.5, 0.25, 0.125, 0.0}},
+            {"cristal", MaterialType::Refractive, {1.5, 0.0, 0.0, 0.0}  },
+        };
+    }
+
+    std::vector<Object> sample_objects() {
+        std::vector<Object> objects;
+        for (std::uint32_t i = 0; i < 40; ++i) {
+            double const x = static_cast<double>(i) * 1.5;
+            if (i % 4 == 0) {
+                objects.push_back({ObjectType::Cylinder, 1, {x, 0.0, 3.0, 0.5, 0.0, 2.0, 0.0}, i});
+            } else {
+                objects.push_back({ObjectType::Sphere, 0, {x, 1.0, 2.0, 0.25}, i * 10});
+            }
+        }
+        return objects;
+    }
+
+    std::vector<render::aabb> sample_bounds(std::vector<Object> const & objects) {
+        std::vector<render::aabb> bounds;
+        for (auto const & obj : objects) {
+            bounds.push_back(render::sphere_bounds({obj.params[0], obj.params[1], obj.params[2]},
+                                                   obj.params[3]));
+        }
+        return bounds;
+    }
+
+    std::string load_error(std::string const & path) {
+        try {
+            render::scene_cache const cache(path);
+        } catch (std::runtime_error const & e) {
+            return e.what();
+        }
+        return {};
+    }
+
+    void flip_byte(std::string const & path, std::streamoff offset) {
+        std::fstream file(path, std::ios::binary | std::ios::in | std::ios::out);
+        file.seekg(offset);
+        char c = 0;
+        file.get(c);
+        file.seekp(offset);
+        file.put(static_cast<char>(c ^ 0x20));
+    }
+
+}  // namespace
+
+TEST(SceneCache, round_trip) {
+    std::string const path = temp_path("utcommon_scene.rsc");
+    auto const mats        = sample_materials();
+    auto const objects     = sample_objects();
+    render::write_scene_cache(path, mats, objects);
+
+    EXPECT_TRUE(render::is_scene_cache(path));
+    render::scene_cache const cache(path);
+    ASSERT_EQ(cache.get_materials().size(), mats.size());
+    for (std::size_t i = 0; i < mats.size(); ++i) {
+        EXPECT_EQ(cache.get_materials()[i].name, mats[i].name);
+        EXPECT_EQ(cache.get_materials()[i].type, mats[i].type);
+        EXPECT_EQ(cache.get_materials()[i].params, mats[i].params);
+    }
+    ASSERT_EQ(cache.get_objects().size(), objects.size());
+    for (std::size_t i = 0; i < objects.size(); ++i) {
+        EXPECT_EQ(cache.get_objects()[i].type, objects[i].type);
+        EXPECT_EQ(cache.get_objects()[i].material_index, objects[i].material_index);
+        EXPECT_EQ(cache.get_objects()[i].params, objects[i].params);
+        EXPECT_EQ(cache.get_objects()[i].line_offset, objects[i].line_offset);
+    }
+    EXPECT_EQ(cache.find_hierarchy(render::cached_bvh::aos), nullptr);
+}
+
+TEST(SceneCache, keeps_hierarchy) {
+    std::string const path = temp_path("utcommon_scene.rsc");
+    auto const objects     = sample_objects();
+    render::bvh const tree(sample_bounds(objects), 4);
+    std::array const hierarchies = {
+        render::cache_hierarchy{render::cached_bvh::soa_spheres, &tree}
+    };
+    render::write_scene_cache(path, sample_materials(), objects, hierarchies);
+
+    render::scene_cache const cache(path);
+    EXPECT_EQ(cache.find_hierarchy(render::cached_bvh::aos), nullptr);
+    render::bvh const * const stored = cache.find_hierarchy(render::cached_bvh::soa_spheres);
+    ASSERT_NE(stored, nullptr);
+    EXPECT_EQ(stored->get_order(), tree.get_order());
+    ASSERT_EQ(stored->get_nodes().size(), tree.get_nodes().size());
+    for (std::size_t i = 0; i < tree.get_nodes().size(); ++i) {
+        EXPECT_EQ(stored->get_nodes()[i].lo, tree.get_nodes()[i].lo);
+        EXPECT_EQ(stored->get_nodes()[i].hi, tree.get_nodes()[i].hi);
+        EXPECT_EQ(stored->get_nodes()[i].offset, tree.get_nodes()[i].offset);
+        EXPECT_EQ(stored->get_nodes()[i].count, tree.get_nodes()[i].count);
+    }
+}
+
+TEST(SceneCache, rejects_damaged_files) {
+    std::string const path = temp_path("utcommon_scene.rsc");
+    render::write_scene_cache(path, sample_materials(), sample_objects());
+    std::string const corrupt = "Error: Corrupt scene cache: [" + path + "]";
+
+    // Un byte cambiado en los datos no pasa la suma de comprobación
+    flip_byte(path, 200);
+    EXPECT_EQ(load_error(path), corrupt);
+
+    render::write_scene_cache(path, sample_materials(), sample_objects());
+    flip_byte(path, 8);
+    EXPECT_EQ(load_error(path), "Error: Unsupported scene cache version: [" + path + "]");
+
+    render::write_scene_cache(path, sample_materials(), sample_objects());
+    std::filesystem::resize_file(path, std::filesystem::file_size(path) - 64);
+    EXPECT_EQ(load_error(path), corrupt);
+
+    std::ofstream(path) << "sphere: 0 0 0 1 mate\n";
+    EXPECT_FALSE(render::is_scene_cache(path));
+}
+
+TEST(SceneCache, rejects_invalid_hierarchy) {
+    std::vector<render::bvh_node> nodes(3);
+    nodes[0].offset = 5;  // hijo derecho fuera del array
+    nodes[0].count  = 0;
+    EXPECT_THROW(render::bvh(nodes, {0, 1}), std::runtime_error);
+
+    nodes[0].offset = 2;
+    nodes[1]        = {{}, {}, 0, 1, 0};
+    nodes[2]        = {{}, {}, 1, 2, 0};  // hoja que sale de la permutación
+    EXPECT_THROW(render::bvh(nodes, {0, 1}), std::runtime_error);
+
+    nodes[2].count = 1;
+    EXPECT_NO_THROW(render::bvh(nodes, {0, 1}));
+}
@@ -0,0 +1,87 @@
+#include <gtest/gtest.h>
+
+#include "scene_reload.hpp"
+
+#include <vector>
+
+namespace {
+
+    std::vector<Material> materials() {
+        return {
+            {"a", MaterialType::Matte, {0.5, 0.5, 0.5, 0.0}},
+            {"b", MaterialType::Metal, {0.8, 0.8, 0.8, 0.1}},
+        };
+    }
+
+    std::vector<Object> objects(std::size_t n) {
+        std::vector<Object> objs;
+        for (std::size_t i = 0; i < n; ++i) {
+            auto const x = static_cast<double>(i);
+            objs.push_back({ObjectType::Sphere, 0, {x, 0.0, 0.0, 0.5}, 10 * i});
+        }
+        return objs;
+    }
+
+    // Escena de prueba: cuenta cómo se ha obtenido
+    struct fake_scene {
+        int builds  = 0;
+        int updates = 0;
+
+        void update(std::vector<Material> const &, std::vector<Object> const &,
+                    render::scene_diff const &) {
+            ++updates;
+        }
+    };
+
+}  // namespace
+
+TEST(test_scene_reload, diff_finds_changed_entries) {
+    auto const mats            = materials();
+    auto const objs            = objects(8);
+    auto new_mats              = mats;
+    auto new_objs              = objs;
+    new_mats[0].name           = "renamed";  // los objetos ya apuntan por índice
+    new_mats[1].params[3]      = 0.3;
+    new_objs[2].params[1]      = 1.0;
+    new_objs[5].material_index = 1;
+    for (auto & obj : new_objs) {
+        obj.line_offset += 100;  // una línea insertada antes desplaza todas las demás
+    }
+    auto const diff = render::diff_scenes(mats, objs, new_mats, new_objs);
+    EXPECT_FALSE(diff.structural);
+    EXPECT_EQ(diff.materials, (std::vector<std::uint32_t>{1}));
+    EXPECT_EQ(diff.objects, (std::vector<std::uint32_t>{2, 5}));
+    EXPECT_TRUE(diff.refittable(new_objs.size()));
+}
+
+TEST(test_scene_reload, diff_detects_structural_changes) {
+    auto const mats = materials();
+    auto const objs = objects(8);
+    EXPECT_TRUE(render::diff_scenes(mats, objs, mats, objects(9)).structural);
+    EXPECT_TRUE(render::diff_scenes(mats, objs, {mats[0]}, objs).structural);
+    auto retyped    = objs;
+    retyped[3].type = ObjectType::Cylinder;
+    auto const diff = render::diff_scenes(mats, objs, mats, retyped);
+    EXPECT_TRUE(diff.structural);
+    EXPECT_FALSE(diff.refittable(retyped.size()));
+}
+
+TEST(test_scene_reload, reload_updates_small_changes_only) {
+    auto const build = [](auto const &, auto const &) { return fake_scene{1, 0}; };
+    auto const first = render::reload_scene<fake_scene>(nullptr, materials(), objects(8), build);
+    EXPECT_EQ(first.scene.builds, 1);
+
+    auto few          = objects(8);
+    few[0].params[3]  = 0.25;
+    auto const second = render::reload_scene(&first, materials(), few, build);
+    EXPECT_EQ(second.scene.updates, 1);
+    EXPECT_EQ(second.objects[0].params[3], 0.25);
+
+    auto many = objects(8);
+    for (std::size_t i = 0; i < 4; ++i) {
+        many[i].params[0] += 1.0;
+    }
+    auto const third = render::reload_scene(&second, materials(), many, build);
+    EXPECT_EQ(third.scene.updates, 0);
+    EXPECT_EQ(third.scene.builds, 1);
+}
@@ -0,0 +1,57 @@
+#include <gtest/gtest.h>
+
+#include "stats.hpp"
+
+#include <sstream>
+#include <string>
+
+TEST(Stats, merge_adds_counters) {
+    render::ray_stats a(3);
+    a.path_end(1);
+    a.path_end(3);
+    a.count_box();
+    a.count_primitives(8);
+    render::ray_stats b(3);
+    b.path_end(2);
+    b.merge(a);
+    EXPECT_EQ(b.primary, 3U);
+    EXPECT_EQ(b.secondary, 3U);
+    EXPECT_EQ(b.box_tests, 1U);
+    EXPECT_EQ(b.primitive_tests, 8U);
+    EXPECT_EQ(b.path_lengths, (std::vector<std::uint64_t>{0, 1, 1, 1}));
+}
+
+TEST(Stats, sink_tracks_threads) {
+    render::render_stats stats;
+    render::tile_stats_sink sink(stats, 2, 2);
+    render::ray_stats tile(2);
+    tile.path_end(2);
+    sink.add(tile, 1, 0.5);
+    sink.add(tile, 1, 0.25);
+    EXPECT_EQ(stats.rays.primary, 2U);
+    EXPECT_EQ(stats.tiles, (std::vector<std::uint64_t>{0, 2}));
+    EXPECT_DOUBLE_EQ(stats.busy_seconds[1], 0.75);
+}
+
+TEST(Stats, writes_json) {
+    render::run_report report;
+    report.engine                = "aos";
+    report.width                 = 4;
+    report.height                = 2;
+    report.phases.render         = 2.0;
+    report.render.render_seconds = 2.0;
+    report.render.rays           = render::ray_stats(1);
+    report.render.rays.path_end(1);
+    report.render.rays.count_primitives(6);
+    report.render.busy_seconds = {1.0, 2.0};
+    report.render.tiles        = {1, 1};
+
+    std::ostringstream out;
+    render::write_stats_json(out, report);
+    std::string const json = out.str();
+    EXPECT_NE(json.find("\"engine\": \"aos\""), std::string::npos);
+    EXPECT_NE(json.find("\"primary\": 1, \"secondary\": 0, \"shadow\": 0"), std::string::npos);
+    EXPECT_NE(json.find("\"primitive\": 6"), std::string::npos);
+    EXPECT_NE(json.find("\"path_length_histogram\": [0, 1]"), std::string::npos);
+    EXPECT_NE(json.find("\"utilisation\": [0.5, 1]"), std::string::npos);
+}
@@ -0,0 +1,69 @@
+#include <gtest/gtest.h>
+
+#include "thread_pool.hpp"
+#include "tiles.hpp"
+
+#include <atomic>
+#include <stdexcept>
+#include <vector>
+
+TEST(ThreadPool, runs_every_task_once) {
+    render::work_stealing_pool pool(4);
+    std::vector<std::atomic<int>> hits(1'000);
+    for (int round = 0; round < 3; ++round) {
+        pool.run(hits.size(), [&](std::size_t i) { hits[i].fetch_add(1); });
+    }
+    for (auto const & h : hits) {
+        EXPECT_EQ(h.load(), 3);
+    }
+}
+
+TEST(ThreadPool, survives_many_short_runs) {
+    // Regresión: un hilo que despertaba antes de llenar las colas bloqueaba run()
+    for (unsigned threads : {1U, 4U}) {
+        render::work_stealing_pool pool(threads);
+        std::atomic<std::size_t> count{0};
+        for (int round = 0; round < 50'000; ++round) {
+            pool.run(threads * 4, [&](std::size_t) { count.fetch_add(1); });
+        }
+        EXPECT_EQ(count.load(), 50'000U * threads * 4);
+    }
+}
+
+TEST(ThreadPool, propagates_exceptions) {
+    render::work_stealing_pool pool(3);
+    EXPECT_THROW(pool.run(64,
+                          [](std::size_t i) {
+                              if (i == 17) {
+                                  throw std::runtime_error("boom");
+                              }
+                          }),
+                 std::runtime_error);
+    // El conjunto sigue siendo utilizable tras un fallo
+    std::atomic<std::size_t> count{0};
+    pool.run(10, [&](std::size_t) { count.fetch_add(1); });
+    EXPECT_EQ(count.load(), 10U);
+}
+
+TEST(ThreadPool, resolve_thread_count) {
+    EXPECT_EQ(render::resolve_thread_count(3), 3U);
+    EXPECT_GE(render::resolve_thread_count(0), 1U);
+}
+
+TEST(Tiles, cover_image_exactly) {
+    int const width  = 37;
+    int const height = 21;
+    std::vector<int> covered(static_cast<std::size_t>(width * height), 0);
+    for (auto const & t : render::make_tiles(width, height)) {
+        EXPECT_LE(t.rows, render::tile_size);
+        EXPECT_LE(t.cols, render::tile_size);
+        for (int r = t.row0; r < t.row0 + t.rows; ++r) {
+            for (int c = t.col0; c < t.col0 + t.cols; ++c) {
+                ++covered[static_cast<std::size_t>(r * width + c)];
+            }
+        }
+    }
+    for (int v : covered) {
+        EXPECT_EQ(v, 1);
+    }
+}
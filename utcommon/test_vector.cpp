@@ -1,6 +1,10 @@
 #include <gtest/gtest.h>
 
 #include "vector.hpp"
+#include "vector_pack.hpp"
+
+#include <array>
+#include <cstddef>
 
 TEST(test_vector, magnitude_zero) {
     render::vector vec{0.0, 0.0, 0.0};
@@ -10,4 +14,73 @@ TEST(test_vector, magnitude_zero) {
 TEST(test_vector, magnitude_positive) {
     render::vector vec{3.0, 4.0, 0.0};
     EXPECT_EQ(vec.magnitude(), 5.0);
-}
\ No newline at end of file
+}
+
+TEST(test_vector, dot_product) {
+    render::vector a{1.0, 2.0, 3.0};
+    render::vector b{4.0, -5.0, 6.0};
+    EXPECT_EQ(a.dot(b), 12.0);
+}
+
+TEST(test_vector, cross_product) {
+    render::vector x{1.0, 0.0, 0.0};
+    render::vector y{0.0, 1.0, 0.0};
+    render::vector z = x.cross(y);
+    EXPECT_EQ(z.get_x(), 0.0);
+    EXPECT_EQ(z.get_y(), 0.0);
+    EXPECT_EQ(z.get_z(), 1.0);
+}
+
+TEST(test_vector, normalized_has_unit_length) {
+    render::vector vec{3.0, 0.0, 4.0};
+    EXPECT_DOUBLE_EQ(vec.normalized().magnitude(), 1.0);
+    EXPECT_DOUBLE_EQ(vec.normalized().get_x(), 0.6);
+}
+
+TEST(test_vector, evaluates_at_compile_time) {
+    constexpr render::vector a{1.0, 2.0, 3.0};
+    constexpr render::vector b{4.0, -5.0, 6.0};
+    static_assert(a.dot(b) == 12.0);
+    static_assert((a + b).get_y() == -3.0);
+    static_assert((2.0 * a - b).get_x() == -2.0);
+    static_assert(a.cross(b).get_z() == -13.0);
+    static_assert(render::vector{1e-9, 0.0, -1e-9}.near_zero());
+}
+
+TEST(test_vector, single_precision) {
+    render::basic_vector<float> const v{3.0F, 0.0F, 4.0F};
+    EXPECT_EQ(v.magnitude(), 5.0F);
+    render::vector const wide(v);
+    EXPECT_EQ(wide.get_z(), 4.0);
+}
+
+TEST(test_vector, pack_matches_scalar) {
+    std::array<render::vector, 8> a;
+    std::array<render::vector, 8> b;
+    render::vector3_pack<8> pa;
+    render::vector3_pack<8> pb;
+    for (std::size_t i = 0; i < 8; ++i) {
+        double const k = static_cast<double>(i);
+        a[i]           = {k + 0.5, 2.0 - k, 0.25 * k};
+        b[i]           = {-1.0, k * k, 3.0 + k};
+        pa.set_lane(i, a[i]);
+        pb.set_lane(i, b[i]);
+    }
+    auto const dots  = pa.dot(pb);
+    auto const cross = pa.cross(pb);
+    auto const sum   = pa + pb;
+    auto const unit  = pb.normalized();
+    for (std::size_t i = 0; i < 8; ++i) {
+        EXPECT_EQ(dots[i], a[i].dot(b[i]));
+        EXPECT_EQ(cross.lane(i).get_x(), a[i].cross(b[i]).get_x());
+        EXPECT_EQ(cross.lane(i).get_z(), a[i].cross(b[i]).get_z());
+        EXPECT_EQ(sum.lane(i).get_y(), (a[i] + b[i]).get_y());
+        EXPECT_EQ(unit.lane(i).get_z(), b[i].normalized().get_z());
+    }
+}
+
+TEST(test_vector, pack_broadcast) {
+    constexpr auto p = render::vector3_pack<4, float>::broadcast({1.0F, 2.0F, 3.0F});
+    static_assert(p.dot(p)[3] == 14.0F);
+    EXPECT_EQ(p.lane(2).get_y(), 2.0F);
+}
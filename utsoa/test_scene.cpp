@@ -0,0 +1,187 @@
+#include <gtest/gtest.h>
+
+#include "renderer.hpp"
+#include "scene.hpp"
+
+#include <filesystem>
+#include <limits>
+#include <random>
+#include <stdexcept>
+
+namespace {
+
+    render::soa::scene make_scene() {
+        std::vector<Material> mats = {{"m", MaterialType::Matte, {0.5, 0.5, 0.5}}};
+        std::vector<Object> objs   = {
+            {ObjectType::Sphere, 0, {0.0, 0.0, 10.0, 1.0}, 0},
+            {ObjectType::Sphere, 0, {0.0, 0.0, 5.0, 1.0}, 0},
+            {ObjectType::Cylinder, 0, {5.0, 0.0, 5.0, 1.0, 0.0, 2.0, 0.0}, 0},
+        };
+        return render::soa::scene(mats, objs);
+    }
+
+}  // namespace
+
+TEST(test_scene, closest_hit_picks_nearest) {
+    auto scn = make_scene();
+    render::ray r{{0.0, 0.0, 0.0}, {0.0, 0.0, 1.0}};
+    render::hit_record rec;
+    ASSERT_TRUE(scn.closest_hit(r, 1e-3, std::numeric_limits<double>::infinity(), rec));
+    EXPECT_DOUBLE_EQ(rec.t, 4.0);
+    EXPECT_DOUBLE_EQ(rec.normal.get_z(), -1.0);
+    EXPECT_EQ(rec.material, 0);
+}
+
+TEST(test_scene, closest_hit_cylinder) {
+    auto scn = make_scene();
+    render::ray r{{5.0, 0.0, 0.0}, {0.0, 0.0, 1.0}};
+    render::hit_record rec;
+    ASSERT_TRUE(scn.closest_hit(r, 1e-3, std::numeric_limits<double>::infinity(), rec));
+    EXPECT_DOUBLE_EQ(rec.t, 4.0);
+}
+
+TEST(test_scene, closest_hit_miss) {
+    auto scn = make_scene();
+    render::ray r{{0.0, 0.0, 0.0}, {0.0, 1.0, 0.0}};
+    render::hit_record rec;
+    EXPECT_FALSE(scn.closest_hit(r, 1e-3, std::numeric_limits<double>::infinity(), rec));
+}
+
+// En float el impacto elegido se recalcula en double: t y normal exactos
+TEST(test_scene, f32_refines_hit_in_double) {
+    std::vector<Material> mats = {{"m", MaterialType::Matte, {0.5, 0.5, 0.5}}};
+    std::vector<Object> objs   = {
+        {ObjectType::Sphere, 0, {0.1, 0.0, 10.0, 1.0}, 0},
+        {ObjectType::Cylinder, 0, {5.0, 0.0, 5.0, 1.0, 0.0, 2.0, 0.0}, 0},
+    };
+    render::soa::scene const wide(mats, objs);
+    render::soa::scene const narrow(mats, objs, render::soa::simd_level::automatic,
+                                    render::accel_kind::bvh, render::soa::precision::f32);
+    EXPECT_EQ(narrow.get_precision(), render::soa::precision::f32);
+    for (double const x : {0.0, 0.3, 5.0, 5.7}) {
+        render::ray const r{{x, 0.2, 0.0}, render::vector{0.0, 0.01, 1.0}.normalized()};
+        render::hit_record a;
+        render::hit_record b;
+        ASSERT_TRUE(wide.closest_hit(r, 1e-3, std::numeric_limits<double>::infinity(), a));
+        ASSERT_TRUE(narrow.closest_hit(r, 1e-3, std::numeric_limits<double>::infinity(), b));
+        EXPECT_EQ(a.t, b.t);
+        EXPECT_EQ(a.normal.get_z(), b.normal.get_z());
+    }
+}
+
+TEST(test_scene, objects_split_by_type) {
+    auto scn = make_scene();
+    EXPECT_EQ(scn.get_spheres().size(), 2U);
+    ASSERT_EQ(scn.get_cylinders().size(), 1U);
+    EXPECT_DOUBLE_EQ(scn.get_cylinders().ay[0], 1.0);
+    EXPECT_DOUBLE_EQ(scn.get_cylinders().half_height[0], 1.0);
+}
+
+TEST(test_scene, loads_compiled_scene) {
+    std::vector<Material> mats = {{"m", MaterialType::Matte, {0.5, 0.5, 0.5}}};
+    std::vector<Object> objs;
+    for (std::uint32_t i = 0; i < 50; ++i) {
+        double const x = static_cast<double>((i * 37) % 50);
+        objs.push_back({ObjectType::Sphere, 0, {x, 0.0, 10.0, 0.5}, i});
+    }
+    std::string const path = (std::filesystem::temp_directory_path() / "utsoa.rsc").string();
+
+    // Sin jerarquías guardadas se construyen al cargar y el resultado es el mismo
+    render::write_scene_cache(path, mats, objs);
+    render::soa::scene const text(mats, objs);
+    render::soa::scene const compiled(render::scene_cache{path});
+    EXPECT_EQ(compiled.get_sphere_bvh().get_order(), text.get_sphere_bvh().get_order());
+    EXPECT_EQ(compiled.get_spheres().cx, text.get_spheres().cx);
+    EXPECT_TRUE(compiled.get_cylinder_bvh().empty());
+}
+
+TEST(test_scene, wavefront_matches_recursive) {
+    std::vector<Material> mats = {
+        {"mate",   MaterialType::Matte,      {0.5, 0.4, 0.3, 0.0}},
+        {"metal",  MaterialType::Metal,      {0.8, 0.8, 0.9, 0.2}},
+        {"vidrio", MaterialType::Refractive, {1.5, 0.0, 0.0, 0.0}},
+    };
+    std::vector<Object> objs = {
+        {ObjectType::Sphere, 0, {0.0, -101.0, 0.0, 100.0}, 0},
+        {ObjectType::Sphere, 1, {-1.2, 0.0, 0.0, 0.6}, 1},
+        {ObjectType::Sphere, 2, {0.0, 0.0, 0.0, 0.6}, 2},
+        {ObjectType::Cylinder, 0, {1.2, 0.0, 0.0, 0.4, 0.0, 1.0, 0.0}, 3},
+    };
+    render::soa::scene const scn(mats, objs);
+    Config cfg;
+    cfg.camera_position    = {0.0, 0.5, -5.0};
+    cfg.samples_per_pixel  = 24;
+    cfg.max_depth          = 6;
+    cfg.adaptive_threshold = 0.02;
+    render::work_stealing_pool pool(2);
+    auto const wavefront = render::soa::integrator::wavefront;
+
+    // Mismos colores, mismos rayos y mismas pruebas, también con muestreo adaptativo
+    render::render_stats recursive_stats;
+    render::render_stats wavefront_stats;
+    auto const image = render::soa::render_image(cfg, scn, 40, 24, pool, {}, &recursive_stats);
+    EXPECT_EQ(render::soa::render_image(cfg, scn, 40, 24, pool, {}, &wavefront_stats, wavefront),
+              image);
+    EXPECT_EQ(wavefront_stats.rays.primary, recursive_stats.rays.primary);
+    EXPECT_EQ(wavefront_stats.rays.secondary, recursive_stats.rays.secondary);
+    EXPECT_EQ(wavefront_stats.rays.box_tests, recursive_stats.rays.box_tests);
+    EXPECT_EQ(wavefront_stats.rays.path_lengths, recursive_stats.rays.path_lengths);
+
+    render::progress_state recursive_state(40, 24, 5, 0);
+    render::progress_state wavefront_state(40, 24, 5, 0);
+    for (int pass = 0; pass < 2; ++pass) {
+        render::soa::render_pass(cfg, scn, recursive_state, pool);
+        render::soa::render_pass(cfg, scn, wavefront_state, pool, nullptr, wavefront);
+    }
+    EXPECT_EQ(wavefront_state.image(), recursive_state.image());
+
+    EXPECT_EQ(render::soa::parse_integrator("recursive"), render::soa::integrator::recursive);
+    EXPECT_THROW(render::soa::parse_integrator("stream"), std::runtime_error);
+}
+
+TEST(test_scene, update_matches_rebuild) {
+    std::mt19937_64 gen(5);
+    std::uniform_real_distribution<double> pos(-20.0, 20.0);
+    std::vector<Material> mats = {{"m", MaterialType::Matte, {0.5, 0.5, 0.5}},
+                                  {"n", MaterialType::Metal, {0.9, 0.9, 0.9, 0.0}}};
+    std::vector<Object> objs;
+    for (int i = 0; i < 300; ++i) {
+        double const x = pos(gen), y = pos(gen), z = pos(gen);
+        if (i % 3 == 0) {
+            objs.push_back({ObjectType::Cylinder, 0, {x, y, z, 0.5, 1.0, 2.0, 0.5}, 0});
+        } else {
+            objs.push_back({ObjectType::Sphere, 0, {x, y, z, 1.0}, 0});
+        }
+    }
+    auto new_mats         = mats;
+    auto new_objs         = objs;
+    new_mats[0].params[1] = 0.1;
+    for (std::size_t i = 0; i < new_objs.size(); i += 13) {
+        new_objs[i].params[0] += 3.0;
+        new_objs[i].params[3] *= 2.0;
+        new_objs[i].material_index = 1;
+    }
+    auto const diff = render::diff_scenes(mats, objs, new_mats, new_objs);
+    ASSERT_TRUE(diff.refittable(new_objs.size()));
+
+    double const inf = std::numeric_limits<double>::infinity();
+    for (auto const prec : {render::soa::precision::f64, render::soa::precision::f32}) {
+        render::soa::scene scn(mats, objs, render::soa::simd_level::automatic,
+                               render::accel_kind::bvh, prec);
+        scn.update(new_mats, new_objs, diff);
+        render::soa::scene const fresh(new_mats, new_objs, render::soa::simd_level::automatic,
+                                       render::accel_kind::none, prec);
+        EXPECT_DOUBLE_EQ(scn.material_at(0).reflectance.get_y(), 0.1);
+        for (int i = 0; i < 2'000; ++i) {
+            render::vector const dir{pos(gen), pos(gen), pos(gen)};
+            render::ray const r{{0.0, 0.0, 0.0}, dir.normalized()};
+            render::hit_record a, b;
+            bool const hit_a = fresh.closest_hit(r, 1e-3, inf, a);
+            ASSERT_EQ(hit_a, scn.closest_hit(r, 1e-3, inf, b));
+            if (hit_a) {
+                EXPECT_EQ(a.t, b.t);
+                EXPECT_EQ(a.material, b.material);
+            }
+        }
+    }
+}
@@ -0,0 +1,191 @@
+#include <gtest/gtest.h>
+
+#include "simd_kernels.hpp"
+
+#include <cstddef>
+#include <cmath>
+#include <cstdint>
+#include <random>
+#include <vector>
+
+namespace {
+
+    using render::soa::simd_level;
+
+    // 37 objetos: no es múltiplo de 4 ni de 8, así se prueban los bloques incompletos
+    constexpr std::size_t object_count = 37;
+    constexpr int ray_count            = 2'000;
+
+    struct random_scene {
+        std::vector<double> cx, cy, cz, ax, ay, az, radius, half_height;
+        std::vector<render::soa::ray_view> rays;
+
+        explicit random_scene(std::uint64_t seed) {
+            std::mt19937_64 gen(seed);
+            std::uniform_real_distribution<double> pos(-5.0, 5.0);
+            std::uniform_real_distribution<double> size(0.1, 1.5);
+            for (std::size_t i = 0; i < object_count; ++i) {
+                cx.push_back(pos(gen));
+                cy.push_back(pos(gen));
+                cz.push_back(pos(gen));
+                double x = pos(gen), y = pos(gen), z = pos(gen);
+                double const m = std::sqrt(x * x + y * y + z * z);
+                ax.push_back(x / m);
+                ay.push_back(y / m);
+                az.push_back(z / m);
+                radius.push_back(size(gen));
+                half_height.push_back(size(gen));
+            }
+            for (int i = 0; i < ray_count; ++i) {
+                double x = pos(gen), y = pos(gen), z = pos(gen);
+                double const m = std::sqrt(x * x + y * y + z * z);
+                double const ox = pos(gen) * 2.0, oy = pos(gen) * 2.0, oz = pos(gen) * 2.0;
+                rays.push_back({ox, oy, oz, x / m, y / m, z / m});
+            }
+        }
+
+        [[nodiscard]] render::soa::sphere_view spheres() const {
+            return {cx.data(), cy.data(), cz.data(), radius.data(), object_count};
+        }
+
+        [[nodiscard]] render::soa::cylinder_view cylinders() const {
+            return {cx.data(), cy.data(), cz.data(), ax.data(), ay.data(), az.data(),
+                    radius.data(), half_height.data(), object_count};
+        }
+    };
+
+    // La misma escena con las columnas en float
+    struct random_scene_f32 {
+        std::vector<float> cx, cy, cz, ax, ay, az, radius, half_height;
+
+        explicit random_scene_f32(random_scene const & scn)
+            : cx{narrow(scn.cx)}, cy{narrow(scn.cy)}, cz{narrow(scn.cz)}, ax{narrow(scn.ax)},
+              ay{narrow(scn.ay)}, az{narrow(scn.az)}, radius{narrow(scn.radius)},
+              half_height{narrow(scn.half_height)} {}
+
+        static std::vector<float> narrow(std::vector<double> const & values) {
+            std::vector<float> out;
+            for (double const v : values) {
+                out.push_back(static_cast<float>(v));
+            }
+            return out;
+        }
+
+        [[nodiscard]] render::soa::sphere_view_f32 spheres() const {
+            return {cx.data(), cy.data(), cz.data(), radius.data(), object_count};
+        }
+
+        [[nodiscard]] render::soa::cylinder_view_f32 cylinders() const {
+            return {cx.data(), cy.data(), cz.data(), ax.data(), ay.data(), az.data(),
+                    radius.data(), half_height.data(), object_count};
+        }
+    };
+
+    void expect_same_as_scalar(simd_level level) {
+        auto const kernels = render::soa::select_kernels(level);
+        if (kernels.level != level) {
+            GTEST_SKIP() << render::soa::simd_level_name(level) << " not supported";
+        }
+        random_scene const scn(42);
+        int hits = 0;
+        for (auto const & r : scn.rays) {
+            double ref_t = 1e30, simd_t = 1e30;
+            std::size_t ref_i = 0, simd_i = 0;
+            bool const ref  = render::soa::spheres_scalar(r, scn.spheres(), 1e-3, ref_t, ref_i);
+            bool const simd = kernels.spheres(r, scn.spheres(), 1e-3, simd_t, simd_i);
+            ASSERT_EQ(ref, simd);
+            EXPECT_EQ(ref_t, simd_t);
+            EXPECT_EQ(ref_i, simd_i);
+
+            double ref_ct = 1e30, simd_ct = 1e30;
+            bool const ref_c =
+                render::soa::cylinders_scalar(r, scn.cylinders(), 1e-3, ref_ct, ref_i);
+            bool const simd_c = kernels.cylinders(r, scn.cylinders(), 1e-3, simd_ct, simd_i);
+            ASSERT_EQ(ref_c, simd_c);
+            EXPECT_EQ(ref_ct, simd_ct);
+            EXPECT_EQ(ref_i, simd_i);
+            hits += (ref ? 1 : 0) + (ref_c ? 1 : 0);
+        }
+        EXPECT_GT(hits, 0);
+    }
+
+    void expect_f32_same_as_scalar(simd_level level) {
+        auto const kernels = render::soa::select_kernels(level);
+        if (kernels.level != level) {
+            GTEST_SKIP() << render::soa::simd_level_name(level) << " not supported";
+        }
+        random_scene const wide(42);
+        random_scene_f32 const scn(wide);
+        for (auto const & r : wide.rays) {
+            double ref_t = 1e30, simd_t = 1e30;
+            std::size_t ref_i = 0, simd_i = 0;
+            bool const ref =
+                render::soa::spheres_scalar_f32(r, scn.spheres(), 1e-3, ref_t, ref_i);
+            bool const simd = kernels.spheres_f32(r, scn.spheres(), 1e-3, simd_t, simd_i);
+            ASSERT_EQ(ref, simd);
+            EXPECT_EQ(ref_t, simd_t);
+            EXPECT_EQ(ref_i, simd_i);
+
+            double ref_ct = 1e30, simd_ct = 1e30;
+            bool const ref_c =
+                render::soa::cylinders_scalar_f32(r, scn.cylinders(), 1e-3, ref_ct, ref_i);
+            bool const simd_c = kernels.cylinders_f32(r, scn.cylinders(), 1e-3, simd_ct, simd_i);
+            ASSERT_EQ(ref_c, simd_c);
+            EXPECT_EQ(ref_ct, simd_ct);
+            EXPECT_EQ(ref_i, simd_i);
+        }
+    }
+
+}  // namespace
+
+TEST(test_simd, avx2_matches_scalar) {
+    expect_same_as_scalar(simd_level::avx2);
+}
+
+TEST(test_simd, avx512_matches_scalar) {
+    expect_same_as_scalar(simd_level::avx512);
+}
+
+TEST(test_simd, avx2_f32_matches_scalar_f32) {
+    expect_f32_same_as_scalar(simd_level::avx2);
+}
+
+TEST(test_simd, avx512_f32_matches_scalar_f32) {
+    expect_f32_same_as_scalar(simd_level::avx512);
+}
+
+// En float casi todos los rayos eligen el mismo objeto que en double y a la misma distancia,
+// salvo el error de redondeo
+TEST(test_simd, f32_close_to_f64) {
+    random_scene const wide(7);
+    random_scene_f32 const narrow(wide);
+    int same = 0;
+    int hits = 0;
+    for (auto const & r : wide.rays) {
+        double t = 1e30, t_f32 = 1e30;
+        std::size_t i = 0, i_f32 = 0;
+        bool const hit = render::soa::spheres_scalar(r, wide.spheres(), 1e-3, t, i);
+        bool const hit_f32 =
+            render::soa::spheres_scalar_f32(r, narrow.spheres(), 1e-3, t_f32, i_f32);
+        if (hit and hit_f32 and (i == i_f32)) {
+            ++same;
+            EXPECT_NEAR(t, t_f32, 1e-4 * t);
+        }
+        hits += hit ? 1 : 0;
+    }
+    EXPECT_GT(hits, 0);
+    EXPECT_GE(same, hits * 99 / 100);
+}
+
+TEST(test_simd, parse_level) {
+    EXPECT_EQ(render::soa::parse_simd_level("scalar"), simd_level::scalar);
+    EXPECT_EQ(render::soa::parse_simd_level("auto"), simd_level::automatic);
+    EXPECT_THROW(render::soa::parse_simd_level("sse9"), std::runtime_error);
+}
+
+TEST(test_simd, parse_precision) {
+    EXPECT_EQ(render::soa::parse_precision("double"), render::soa::precision::f64);
+    EXPECT_EQ(render::soa::parse_precision("float"), render::soa::precision::f32);
+    EXPECT_STREQ(render::soa::precision_name(render::soa::precision::f32), "float");
+    EXPECT_THROW(render::soa::parse_precision("half"), std::runtime_error);
+}